@@ -0,0 +1,93 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// LuaConnect/BufferView.h
+///////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef LUACONNECT_BUFFERVIEW
+#define LUACONNECT_BUFFERVIEW
+
+#include "Config.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Preprocessor
+///////////////////////////////////////////////////////////////////////////////////////////////////
+#include "Helpers\Ref.h"
+
+#include <cstddef>
+#include <type_traits>
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Forward Declarations
+///////////////////////////////////////////////////////////////////////////////////////////////////
+struct lua_State;
+
+namespace LuaConnect
+{
+    class VM;
+}
+
+namespace LuaConnect
+{
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Class - BufferView
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    class LUACONNECT_API BufferView : private Ref
+    {
+        static_assert(std::is_arithmetic<T>::value, "BufferView only supports arithmetic elements.");
+
+        template <typename T>
+        friend class Stack;
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Nested Types
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    private:
+        ///////////////////////////////////////////////////////////////////////////////////////////
+        /// Struct - Buffer
+        ///////////////////////////////////////////////////////////////////////////////////////////
+        struct Buffer
+        {
+            // Null once invalidated, the memory is never owned by Lua
+            T* data;
+            std::size_t size;
+        };
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Static Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    private:
+        static unsigned char s_key;
+
+        static Buffer* GetBuffer(lua_State* state);
+        static bool GetOffset(lua_State* state, const Buffer* buffer, std::size_t& offset);
+        static void PushElement(lua_State* state, const Buffer* buffer, std::size_t offset);
+
+        static int Index(lua_State* state);
+        static int NewIndex(lua_State* state);
+        static int Length(lua_State* state);
+        static int IPairs(lua_State* state);
+        static int Next(lua_State* state);
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    public:
+        BufferView();
+        BufferView(const BufferView<T>& other);
+        BufferView(BufferView<T>&& other);
+        BufferView(VM& vm, T* data, std::size_t size);
+
+        BufferView<T>& operator=(BufferView<T>&& other);
+
+        std::size_t Size() const;
+
+        // Must be called before the memory is released, any later access from Lua raises an error
+        void Invalidate();
+    };
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Inline Includes
+///////////////////////////////////////////////////////////////////////////////////////////////////
+#include "BufferView.inl"
+
+#endif LUACONNECT_BUFFERVIEW
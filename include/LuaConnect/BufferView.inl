@@ -0,0 +1,225 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// LuaConnect/BufferView.inl
+///////////////////////////////////////////////////////////////////////////////////////////////////
+#include "BufferView.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Preprocessor
+///////////////////////////////////////////////////////////////////////////////////////////////////
+#include "Exceptions\LuaException.h"
+#include "Helpers\Balance.h"
+#include "Helpers\Headers.h"
+#include "Helpers\Stack.h"
+#include "VM.h"
+
+#include <cmath>
+
+namespace LuaConnect
+{
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// BufferView - Private Static Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    unsigned char BufferView<T>::s_key = 0;
+
+    template <typename T>
+    typename BufferView<T>::Buffer* BufferView<T>::GetBuffer(lua_State* state)
+    {
+        // Next is handed to scripts directly, so check the argument is a view with this type's metatable
+        Buffer* buffer = nullptr;
+        if (lua_type(state, 1) == LUA_TUSERDATA && lua_getmetatable(state, 1))
+        {
+            lua_rawgetp(state, LUA_REGISTRYINDEX, &s_key);
+            if (lua_rawequal(state, -1, -2))
+                buffer = static_cast<Buffer*>(lua_touserdata(state, 1));
+            lua_pop(state, 2);
+        }
+
+        if (buffer == nullptr)
+            luaL_error(state, "Argument 1 is not a BufferView.");
+        if (buffer->data == nullptr)
+            luaL_error(state, "BufferView has been invalidated.");
+
+        return buffer;
+    }
+    template <typename T>
+    bool BufferView<T>::GetOffset(lua_State* state, const Buffer* buffer, std::size_t& offset)
+    {
+        // Only whole number keys in range name an element, as for a table (where "1" isn't 1)
+        lua_Number index = (lua_type(state, 2) == LUA_TNUMBER ? lua_tonumberx(state, 2, NULL) : 0);
+        if (index != std::floor(index) || index < 1 || index > static_cast<lua_Number>(buffer->size))
+            return false;
+
+        offset = static_cast<std::size_t>(index) - 1;
+        return true;
+    }
+    template <typename T>
+    void BufferView<T>::PushElement(lua_State* state, const Buffer* buffer, std::size_t offset)
+    {
+        if constexpr (std::is_floating_point<T>::value)
+            lua_pushnumber(state, static_cast<lua_Number>(buffer->data[offset]));
+        else
+            lua_pushinteger(state, static_cast<lua_Integer>(buffer->data[offset]));
+    }
+
+    template <typename T>
+    int BufferView<T>::Index(lua_State* state)
+    {
+        Buffer* buffer = GetBuffer(state);
+
+        // Any other key reads as nil, as it would for a missing table field
+        std::size_t offset;
+        if (!GetOffset(state, buffer, offset))
+        {
+            lua_pushnil(state);
+            return 1;
+        }
+
+        PushElement(state, buffer, offset);
+        return 1;
+    }
+    template <typename T>
+    int BufferView<T>::NewIndex(lua_State* state)
+    {
+        if constexpr (std::is_const<T>::value)
+        {
+            return luaL_error(state, "BufferView is read only.");
+        }
+        else
+        {
+            Buffer* buffer = GetBuffer(state);
+
+            std::size_t offset;
+            if (!GetOffset(state, buffer, offset))
+                return luaL_error(state, "BufferView index must be a whole number from 1 to %d.", (int)buffer->size);
+
+            // Convert as any argument would be, rejecting values the element type can't hold
+            try
+            {
+                buffer->data[offset] = Stack<T>::Get(state, 3);
+            }
+            catch (const LuaException& e)
+            {
+                return luaL_error(state, "%s", e.what());
+            }
+
+            return 0;
+        }
+    }
+    template <typename T>
+    int BufferView<T>::Length(lua_State* state)
+    {
+        Buffer* buffer = GetBuffer(state);
+
+        lua_pushinteger(state, static_cast<lua_Integer>(buffer->size));
+        return 1;
+    }
+    template <typename T>
+    int BufferView<T>::IPairs(lua_State* state)
+    {
+        GetBuffer(state);
+
+        // Iterate with Next, starting before the first element
+        lua_pushcfunction(state, &BufferView<T>::Next);
+        lua_pushvalue(state, 1);
+        lua_pushinteger(state, 0);
+
+        return 3;
+    }
+    template <typename T>
+    int BufferView<T>::Next(lua_State* state)
+    {
+        Buffer* buffer = GetBuffer(state);
+
+        lua_Integer index = lua_tointeger(state, 2) + 1;
+        if (index < 1 || static_cast<std::size_t>(index) > buffer->size)
+            return 0;
+
+        lua_pushinteger(state, index);
+        PushElement(state, buffer, static_cast<std::size_t>(index - 1));
+
+        return 2;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// BufferView - Public Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    BufferView<T>::BufferView() : Ref(StateView())
+    { }
+    template <typename T>
+    BufferView<T>::BufferView(const BufferView<T>& other) : Ref(other)
+    { }
+    template <typename T>
+    BufferView<T>::BufferView(BufferView<T>&& other) : Ref(static_cast<Ref&&>(other))
+    { }
+    template <typename T>
+    BufferView<T>::BufferView(VM& vm, T* data, std::size_t size) : Ref(vm.m_state)
+    {
+        Balance b(m_state, 0);
+
+        // Only the pointer and size are stored, the elements stay in C++ memory
+        Buffer* buffer = static_cast<Buffer*>(lua_newuserdata(m_state.state, sizeof(Buffer)));
+        buffer->data = data;
+        buffer->size = size;
+
+        // Every view of this type shares a metatable, protected so scripts can't call the metamethods directly
+        lua_rawgetp(m_state.state, LUA_REGISTRYINDEX, &s_key);
+        if (lua_isnil(m_state.state, -1))
+        {
+            lua_pop(m_state.state, 1);
+            lua_createtable(m_state.state, 0, 5);
+
+            lua_pushcfunction(m_state.state, &BufferView<T>::Index);
+            lua_setfield(m_state.state, -2, "__index");
+            lua_pushcfunction(m_state.state, &BufferView<T>::NewIndex);
+            lua_setfield(m_state.state, -2, "__newindex");
+            lua_pushcfunction(m_state.state, &BufferView<T>::Length);
+            lua_setfield(m_state.state, -2, "__len");
+            lua_pushcfunction(m_state.state, &BufferView<T>::IPairs);
+            lua_setfield(m_state.state, -2, "__ipairs");
+            lua_pushliteral(m_state.state, "BufferView");
+            lua_setfield(m_state.state, -2, "__metatable");
+
+            lua_pushvalue(m_state.state, -1);
+            lua_rawsetp(m_state.state, LUA_REGISTRYINDEX, &s_key);
+        }
+
+        lua_setmetatable(m_state.state, -2);
+
+        int ref = luaL_ref(m_state.state, LUA_REGISTRYINDEX);
+        Ref::Set(ref);
+    }
+
+    template <typename T>
+    BufferView<T>& BufferView<T>::operator=(BufferView<T>&& other)
+    {
+        Ref::operator=(static_cast<Ref&&>(other));
+        return *this;
+    }
+
+    template <typename T>
+    std::size_t BufferView<T>::Size() const
+    {
+        Balance b(m_state, 0);
+
+        Ref::Push();
+        std::size_t size = static_cast<Buffer*>(lua_touserdata(m_state.state, -1))->size;
+        lua_pop(m_state.state, 1);
+
+        return size;
+    }
+
+    template <typename T>
+    void BufferView<T>::Invalidate()
+    {
+        Balance b(m_state, 0);
+
+        // Every copy of the view refers to the same userdata, so this invalidates them all
+        Ref::Push();
+        Buffer* buffer = static_cast<Buffer*>(lua_touserdata(m_state.state, -1));
+        buffer->data = nullptr;
+        buffer->size = 0;
+        lua_pop(m_state.state, 1);
+    }
+}
@@ -12,8 +12,8 @@
 #include "Helpers\Ref.h"
 #include "Helpers\Templates.h"
 
-#include <memory>
 #include <tuple>
+#include <vector>
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 /// Forward Declarations
@@ -22,7 +22,6 @@ struct lua_State;
 
 namespace LuaConnect
 {
-    class State;
     class VM;
 }
 
@@ -34,6 +33,8 @@ namespace LuaConnect
     class LUACONNECT_API Function : private Ref
     {
         friend VM;
+        friend class FunctionArg;
+        friend class Table;
 
         template <typename T>
         friend class Stack;
@@ -48,12 +49,64 @@ namespace LuaConnect
         template <typename R, typename... Args>
         struct CallHandler
         {
-            static R Call(Function& function, const Args&... args);
+            static R Call(StateView state, const Args&... args);
         };
         template <typename... Args>
         struct CallHandler<void, Args...>
         {
-            static void Call(Function& function, const Args&... args);
+            static void Call(StateView state, const Args&... args);
+        };
+
+        ///////////////////////////////////////////////////////////////////////////////////////////
+        /// Struct - ClosureData
+        ///////////////////////////////////////////////////////////////////////////////////////////
+        template <typename F, typename... Upvalues>
+        struct ClosureData
+        {
+        private:
+            static unsigned char s_key;
+
+            static int Destroy(lua_State* state);
+
+        public:
+            static const int UpvalueCount = sizeof...(Upvalues);
+
+            F func;
+            std::tuple<Upvalues...> upvalues;
+
+            ClosureData(F&& func, const Upvalues&... upvalues);
+
+            static void Push(StateView state, F&& func, const Upvalues&... upvalues);
+        };
+
+        ///////////////////////////////////////////////////////////////////////////////////////////
+        /// Struct - StoredTarget
+        ///////////////////////////////////////////////////////////////////////////////////////////
+        template <typename F>
+        struct StoredTarget
+        {
+            template <typename Data>
+            static F Get(Data* data);
+        };
+
+        ///////////////////////////////////////////////////////////////////////////////////////////
+        /// Struct - BoundTarget
+        ///////////////////////////////////////////////////////////////////////////////////////////
+        template <typename F, F Func>
+        struct BoundTarget
+        {
+            template <typename Data>
+            static F Get(Data* data);
+        };
+
+        ///////////////////////////////////////////////////////////////////////////////////////////
+        /// Struct - OverloadTarget
+        ///////////////////////////////////////////////////////////////////////////////////////////
+        template <int I>
+        struct OverloadTarget
+        {
+            template <typename Data>
+            static auto Get(Data* data);
         };
 
         ///////////////////////////////////////////////////////////////////////////////////////////
@@ -68,12 +121,21 @@ namespace LuaConnect
         private:
             using FuncPtr = R(*)(Args...);
 
-        public:
             template <int... Seq>
-            static R PerformCallback(FuncPtr func, std::tuple<const Args&...> args, Index<Seq...>);
+            static bool Matches(lua_State* state, Index<Seq...>);
+
+            template <typename Target, typename Data, int... Seq>
+            static int Invoke(lua_State* state, Index<Seq...>);
+
+        public:
+            static bool Matches(lua_State* state);
 
             template <typename... Upvalues>
             static int Call(lua_State* state);
+            template <R(*Func)(Args...), typename... Upvalues>
+            static int CallBound(lua_State* state);
+            template <typename Target, typename Data>
+            static int CallOverload(lua_State* state);
         };
         template <typename R, typename T, typename... Args>
         class Callback<R(T::*)(Args...)>
@@ -81,12 +143,21 @@ namespace LuaConnect
         private:
             using FuncPtr = R(T::*)(Args...);
 
-        public:
             template <int... Seq>
-            static R PerformCallback(FuncPtr func, T* obj, std::tuple<const Args&...> args, Index<Seq...>);
+            static bool Matches(lua_State* state, Index<Seq...>);
+
+            template <typename Target, typename Data, int... Seq>
+            static int Invoke(lua_State* state, Index<Seq...>);
+
+        public:
+            static bool Matches(lua_State* state);
 
             template <typename... Upvalues>
             static int Call(lua_State* state);
+            template <R(T::*Func)(Args...), typename... Upvalues>
+            static int CallBound(lua_State* state);
+            template <typename Target, typename Data>
+            static int CallOverload(lua_State* state);
         };
         template <typename R, typename T, typename... Args>
         class Callback<R(T::*)(Args...) const>
@@ -94,55 +165,70 @@ namespace LuaConnect
         private:
             using FuncPtr = R(T::*)(Args...) const;
 
-        public:
             template <int... Seq>
-            static R PerformCallback(FuncPtr func, const T* obj, std::tuple<const Args&...> args, Index<Seq...>);
+            static bool Matches(lua_State* state, Index<Seq...>);
+
+            template <typename Target, typename Data, int... Seq>
+            static int Invoke(lua_State* state, Index<Seq...>);
+
+        public:
+            static bool Matches(lua_State* state);
 
             template <typename... Upvalues>
             static int Call(lua_State* state);
+            template <R(T::*Func)(Args...) const, typename... Upvalues>
+            static int CallBound(lua_State* state);
+            template <typename Target, typename Data>
+            static int CallOverload(lua_State* state);
         };
 
         ///////////////////////////////////////////////////////////////////////////////////////////
-        /// Struct - Handler
+        /// Class - Overloaded
         ///////////////////////////////////////////////////////////////////////////////////////////
-        template <typename F>
-        struct Handler;
-
-        template <typename R, typename... Args>
-        struct Handler<R(*)(Args...)>
-        {
-            using FuncPtr = R(*)(Args...);
-            static int Call(std::shared_ptr<State> state, FuncPtr func, std::tuple<const Args&...> args);
-        };
-        template <typename... Args>
-        struct Handler<void(*)(Args...)>
-        {
-            using FuncPtr = void(*)(Args...);
-            static int Call(std::shared_ptr<State> state, FuncPtr func, std::tuple<const Args&...> args);
-        };
-        template <typename T, typename R, typename... Args>
-        struct Handler<R(T::*)(Args...)>
+        template <typename... Fs>
+        class Overloaded
         {
-            using FuncPtr = R(T::*)(Args...);
-            static int Call(std::shared_ptr<State> state, FuncPtr func, T* obj, std::tuple<const Args&...> args);
+        private:
+            template <int... Seq>
+            static int Dispatch(lua_State* state, Index<Seq...>);
+
+        public:
+            static int Call(lua_State* state);
         };
-        template <typename T, typename... Args>
-        struct Handler<void(T::*)(Args...)>
+
+        ///////////////////////////////////////////////////////////////////////////////////////////
+        /// Class - Closure
+        ///////////////////////////////////////////////////////////////////////////////////////////
+        template <typename F, typename Signature = decltype(&F::operator())>
+        class Closure;
+
+        template <typename F, typename R, typename C, typename... Args>
+        class Closure<F, R(C::*)(Args...)>
         {
-            using FuncPtr = void(T::*)(Args...);
-            static int Call(std::shared_ptr<State> state, FuncPtr func, T* obj, std::tuple<const Args&...> args);
+        private:
+            template <typename Data, int... Seq>
+            static int Invoke(lua_State* state, Index<Seq...>);
+
+        public:
+            template <typename... Upvalues>
+            static int Call(lua_State* state);
         };
-        template <typename T, typename R, typename... Args>
-        struct Handler<R(T::*)(Args...) const>
+        template <typename F, typename R, typename C, typename... Args>
+        class Closure<F, R(C::*)(Args...) const> : public Closure<F, R(C::*)(Args...)>
+        { };
+
+        ///////////////////////////////////////////////////////////////////////////////////////////
+        /// Struct - Handler
+        ///////////////////////////////////////////////////////////////////////////////////////////
+        template <typename R, typename F>
+        struct Handler
         {
-            using FuncPtr = R(T::*)(Args...) const;
-            static int Call(std::shared_ptr<State> state, FuncPtr func, const T* obj, std::tuple<const Args&...> args);
+            static int Call(StateView state, const F& call);
         };
-        template <typename T, typename... Args>
-        struct Handler<void(T::*)(Args...) const>
+        template <typename F>
+        struct Handler<void, F>
         {
-            using FuncPtr = void(T::*)(Args...) const;
-            static int Call(std::shared_ptr<State> state, FuncPtr func, const T* obj, std::tuple<const Args&...> args);
+            static int Call(StateView state, const F& call);
         };
 
     ///////////////////////////////////////////////////////////////////////////////////////////////
@@ -151,18 +237,35 @@ namespace LuaConnect
     public:
         template <typename F, typename... Upvalues>
         static Function CreateFunction(VM& vm, F func, const Upvalues&... upvalues);
+        template <auto F, typename... Upvalues>
+        static Function CreateFunction(VM& vm, const Upvalues&... upvalues);
+
+        template <typename... Fs>
+        static Function CreateOverloaded(VM& vm, Fs... funcs);
 
     ///////////////////////////////////////////////////////////////////////////////////////////////
     /// Members
     ///////////////////////////////////////////////////////////////////////////////////////////////
     private:
-        Function(std::shared_ptr<State> state);
+        template <int I, typename Arg, typename Data>
+        static decltype(auto) Argument(StateView state, Data* data, int first);
+
+        template <typename... Args>
+        static constexpr int RequiredArguments();
+
+        template <typename T>
+        static bool MatchesType(lua_State* state, int index);
+
+        Function(StateView state);
 
         template <typename... Args>
-        void PerformCall(std::tuple<const Args&...> args);
+        static int PerformCall(StateView state, int results, std::tuple<const Args&...> args);
+        template <typename R, typename... Args>
+        static std::vector<R> PerformCallAll(StateView state, const Args&... args);
 
     public:
         Function();
+        Function(const Function& other);
         Function(Function&& other);
 
         Function& operator=(Function&& other);
@@ -172,6 +275,8 @@ namespace LuaConnect
 
         template <typename R, typename... Args>
         R Call(const Args&... args);
+        template <typename R, typename... Args>
+        std::vector<R> CallAll(const Args&... args);
     };
 }
 
@@ -9,8 +9,12 @@
 #include "Helpers\Balance.h"
 #include "Helpers\Headers.h"
 #include "Helpers\Stack.h"
+#include "Helpers\UserdataHeader.h"
 
+#include <cmath>
 #include <iostream>
+#include <type_traits>
+#include <utility>
 
 namespace LuaConnect
 {
@@ -18,32 +22,117 @@ namespace LuaConnect
     /// Function::CallHandler - Public Members
     ///////////////////////////////////////////////////////////////////////////////////////////////
     template <typename R, typename... Args>
-    R Function::CallHandler<R, Args...>::Call(Function& function, const Args&... args)
+    R Function::CallHandler<R, Args...>::Call(StateView state, const Args&... args)
     {
+        static_assert(StackOwned<R>::value);
+
+        PerformCall(state, StackSize<R>::value, std::forward_as_tuple(args...));
+
         try
         {
-            function.PerformCall(std::forward_as_tuple(args...));
-            return Stack<R>::Pop(function.m_state);
+            return Stack<R>::Pop(state);
         }
         catch (...)
         {
-            lua_pop(function.m_state->state, 1);
+            lua_pop(state.state, StackSize<R>::value);
             throw;
         }
     }
     template <typename... Args>
-    void Function::CallHandler<void, Args...>::Call(Function& function, const Args&... args)
+    void Function::CallHandler<void, Args...>::Call(StateView state, const Args&... args)
+    {
+        PerformCall(state, 0, std::forward_as_tuple(args...));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Function::ClosureData - Private Static Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    template <typename F, typename... Upvalues>
+    unsigned char Function::ClosureData<F, Upvalues...>::s_key = 0;
+
+    template <typename F, typename... Upvalues>
+    int Function::ClosureData<F, Upvalues...>::Destroy(lua_State* state)
+    {
+        // Lua only calls __gc with the userdata owning this metatable, so it can be used directly
+        ClosureData* data = static_cast<ClosureData*>(lua_touserdata(state, 1));
+        data->~ClosureData();
+
+        return 0;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Function::ClosureData - Public Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    template <typename F, typename... Upvalues>
+    Function::ClosureData<F, Upvalues...>::ClosureData(F&& func, const Upvalues&... upvalues) : func(std::move(func)), upvalues(upvalues...)
+    { }
+
+    template <typename F, typename... Upvalues>
+    void Function::ClosureData<F, Upvalues...>::Push(StateView state, F&& func, const Upvalues&... upvalues)
     {
+        Balance b(state, 1);
+
+        // Store the function and upvalues together in a single userdata (on the stack)
+        ClosureData* data = static_cast<ClosureData*>(lua_newuserdata(state.state, sizeof(ClosureData)));
         try
         {
-            function.PerformCall(std::forward_as_tuple(args...));
-            lua_pop(function.m_state->state, 1);
+            new (data)ClosureData(std::move(func), upvalues...);
         }
         catch (...)
         {
-            lua_pop(function.m_state->state, 1);
+            lua_pop(state.state, 1);
             throw;
         }
+
+        // Every closure of this type shares a metatable which finalizes the data
+        lua_rawgetp(state.state, LUA_REGISTRYINDEX, &s_key);
+        if (lua_isnil(state.state, -1))
+        {
+            lua_pop(state.state, 1);
+            lua_createtable(state.state, 0, 1);
+
+            if (!std::is_trivially_destructible<ClosureData>::value)
+            {
+                lua_pushcfunction(state.state, &Destroy);
+                lua_setfield(state.state, -2, "__gc");
+            }
+
+            lua_pushvalue(state.state, -1);
+            lua_rawsetp(state.state, LUA_REGISTRYINDEX, &s_key);
+        }
+
+        lua_setmetatable(state.state, -2);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Function::StoredTarget - Public Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    template <typename F>
+    template <typename Data>
+    F Function::StoredTarget<F>::Get(Data* data)
+    {
+        return data->func;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Function::BoundTarget - Public Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    template <typename F, F Func>
+    template <typename Data>
+    F Function::BoundTarget<F, Func>::Get(Data* data)
+    {
+        return Func;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Function::OverloadTarget - Public Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    template <int I>
+    template <typename Data>
+    auto Function::OverloadTarget<I>::Get(Data* data)
+    {
+        // Every overload shares a single tuple of function pointers
+        return std::get<I>(data->func);
     }
 
     ///////////////////////////////////////////////////////////////////////////////////////////////
@@ -51,57 +140,131 @@ namespace LuaConnect
     ///////////////////////////////////////////////////////////////////////////////////////////////
     template <typename R, typename... Args>
     template <int... Seq>
-    R Function::Callback<R(*)(Args...)>::PerformCallback(FuncPtr func, std::tuple<const Args&...> args, Index<Seq...>)
+    bool Function::Callback<R(*)(Args...)>::Matches(lua_State* state, Index<Seq...>)
     {
-        return (*func)(std::get<Seq>(args)...);
+        // Trailing optional arguments may be left out
+        int count = lua_gettop(state);
+        if (count < RequiredArguments<Args...>() || count > static_cast<int>(sizeof...(Args)))
+            return false;
+
+        return (MatchesType<std::decay_t<Args>>(state, Seq + 1) && ...);
     }
 
     template <typename R, typename... Args>
-    template <typename... Upvalues>
-    int Function::Callback<R(*)(Args...)>::Call(lua_State* state)
+    template <typename Target, typename Data, int... Seq>
+    int Function::Callback<R(*)(Args...)>::Invoke(lua_State* state, Index<Seq...>)
     {
         // Check we got the correct number of arguments
-        int reqArgs = static_cast<int>(sizeof...(Args));
-        int upvalueCount = static_cast<int>(sizeof...(Upvalues));
+        int reqArgs = RequiredArguments<Args...>() - Data::UpvalueCount;
 
-        if (lua_gettop(state) < reqArgs - upvalueCount)
-            return luaL_error(state, "Not enough arguments, expected %d got %d.", reqArgs - upvalueCount + 1, lua_gettop(state));
+        if (lua_gettop(state) < reqArgs)
+            return luaL_error(state, "Not enough arguments, expected %d got %d.", reqArgs, lua_gettop(state));
 
-        // Create the State needed for calls to C++ code
-        std::shared_ptr<State> luaState(new State(state));
+        // Borrow the State needed for calls to C++ code
+        StateView luaState(state);
 
-        // Get the function pointer from the upvalues
-        FuncPtr* func = (FuncPtr*)lua_touserdata(state, lua_upvalueindex(upvalueCount + 1));
+        // Get the function pointer to call, and any upvalues stored alongside it
+        Data* data = static_cast<Data*>(lua_touserdata(state, lua_upvalueindex(1)));
+        FuncPtr func = Target::Get(data);
 
-        // Create the tuple of arguments
-        std::tuple<Args...> args;
+        // Each argument is taken by reference from the upvalues, or constructed directly from its stack slot
+        auto call = [&]() -> R
+        {
+            return (*func)(Argument<Seq, Args>(luaState, data, 1)...);
+        };
 
-        // Get the upvalues
-        auto upvalueArgs = Template::Split<0, sizeof...(Upvalues)>(Template::Tie(args));
+        // Call the callback handler
         try
         {
-            StackHelper::GetUpvalues(luaState, upvalueArgs);
+            return Handler<R, decltype(call)>::Call(luaState, call);
         }
-        catch (LuaException& e)
+        catch (const LuaException& e)
         {
             return luaL_error(state, "%s", e.what());
         }
-
-        // Get the arguments from the stack
-        auto stackArgs = Template::Split<sizeof...(Upvalues), sizeof...(Args)-sizeof...(Upvalues)>(Template::Tie(args));
-        try
+        catch (const std::exception& e)
         {
-            StackHelper::GetStack(luaState, stackArgs);
+            return luaL_error(state, "Exception during execution: %s", e.what());
         }
-        catch (LuaException& e)
+        catch (...)
         {
-            return luaL_error(state, "%s", e.what());
+            return luaL_error(state, "Unknown exception during execution.");
         }
+    }
+
+    template <typename R, typename... Args>
+    bool Function::Callback<R(*)(Args...)>::Matches(lua_State* state)
+    {
+        return Matches(state, GenSequence<sizeof...(Args)>{});
+    }
+
+    template <typename R, typename... Args>
+    template <typename... Upvalues>
+    int Function::Callback<R(*)(Args...)>::Call(lua_State* state)
+    {
+        using Data = ClosureData<FuncPtr, Upvalues...>;
+        return Invoke<StoredTarget<FuncPtr>, Data>(state, GenSequence<sizeof...(Args)>{});
+    }
+    template <typename R, typename... Args>
+    template <R(*Func)(Args...), typename... Upvalues>
+    int Function::Callback<R(*)(Args...)>::CallBound(lua_State* state)
+    {
+        using Data = ClosureData<None, Upvalues...>;
+        return Invoke<BoundTarget<FuncPtr, Func>, Data>(state, GenSequence<sizeof...(Args)>{});
+    }
+    template <typename R, typename... Args>
+    template <typename Target, typename Data>
+    int Function::Callback<R(*)(Args...)>::CallOverload(lua_State* state)
+    {
+        return Invoke<Target, Data>(state, GenSequence<sizeof...(Args)>{});
+    }
+
+    template <typename R, typename T, typename... Args>
+    template <int... Seq>
+    bool Function::Callback<R(T::*)(Args...)>::Matches(lua_State* state, Index<Seq...>)
+    {
+        // The object must be passed as the first argument, optionally followed by fewer arguments
+        int count = lua_gettop(state) - 1;
+        if (count < RequiredArguments<Args...>() || count > static_cast<int>(sizeof...(Args)) || UserdataHeader::Check<T>(state, 1) == nullptr)
+            return false;
+
+        return (MatchesType<std::decay_t<Args>>(state, Seq + 2) && ...);
+    }
+
+    template <typename R, typename T, typename... Args>
+    template <typename Target, typename Data, int... Seq>
+    int Function::Callback<R(T::*)(Args...)>::Invoke(lua_State* state, Index<Seq...>)
+    {
+        // Check we got the correct number of arguments
+        int reqArgs = RequiredArguments<Args...>() - Data::UpvalueCount + 1;
+
+        if (lua_gettop(state) < reqArgs)
+            return luaL_error(state, "Not enough arguments, expected %d got %d.", reqArgs, lua_gettop(state));
+
+        // Borrow the State needed for calls to C++ code
+        StateView luaState(state);
+
+        // Get the function pointer to call, and any upvalues stored alongside it
+        Data* data = static_cast<Data*>(lua_touserdata(state, lua_upvalueindex(1)));
+        FuncPtr func = Target::Get(data);
+        T* obj = UserdataHeader::Check<T>(state, 1);
+        if (obj == nullptr)
+            return luaL_error(state, "Argument 1 is not the expected userdata type.");
+
+        // Each argument is taken by reference from the upvalues, or constructed directly from its stack slot
+        auto call = [&]() -> R
+        {
+            return (obj->*func)(Argument<Seq, Args>(luaState, data, 2)...);
+        };
 
         // Call the callback handler
         try
         {
-            return Handler<FuncPtr>::Call(luaState, *func, Template::ConstTie(args));
+            return Handler<R, decltype(call)>::Call(luaState, call);
+        }
+        catch (const LuaException& e)
+        {
+            return luaL_error(state, "%s", e.what());
         }
         catch (const std::exception& e)
         {
@@ -114,60 +277,79 @@ namespace LuaConnect
     }
 
     template <typename R, typename T, typename... Args>
-    template <int... Seq>
-    R Function::Callback<R(T::*)(Args...)>::PerformCallback(FuncPtr func, T* obj, std::tuple<const Args&...> args, Index<Seq...>)
+    bool Function::Callback<R(T::*)(Args...)>::Matches(lua_State* state)
     {
-        return (obj->*func)(std::get<Seq>(args)...);
+        return Matches(state, GenSequence<sizeof...(Args)>{});
     }
 
     template <typename R, typename T, typename... Args>
     template <typename... Upvalues>
     int Function::Callback<R(T::*)(Args...)>::Call(lua_State* state)
     {
-        // Check we got the correct number of arguments
-        int reqArgs = static_cast<int>(sizeof...(Args));
-        int upvalueCount = static_cast<int>(sizeof...(Upvalues));
+        using Data = ClosureData<FuncPtr, Upvalues...>;
+        return Invoke<StoredTarget<FuncPtr>, Data>(state, GenSequence<sizeof...(Args)>{});
+    }
+    template <typename R, typename T, typename... Args>
+    template <R(T::*Func)(Args...), typename... Upvalues>
+    int Function::Callback<R(T::*)(Args...)>::CallBound(lua_State* state)
+    {
+        using Data = ClosureData<None, Upvalues...>;
+        return Invoke<BoundTarget<FuncPtr, Func>, Data>(state, GenSequence<sizeof...(Args)>{});
+    }
+    template <typename R, typename T, typename... Args>
+    template <typename Target, typename Data>
+    int Function::Callback<R(T::*)(Args...)>::CallOverload(lua_State* state)
+    {
+        return Invoke<Target, Data>(state, GenSequence<sizeof...(Args)>{});
+    }
 
-        if (lua_gettop(state) < reqArgs - upvalueCount + 1)
-            return luaL_error(state, "Not enough arguments, expected %d got %d.", reqArgs - upvalueCount + 1, lua_gettop(state));
+    template <typename R, typename T, typename... Args>
+    template <int... Seq>
+    bool Function::Callback<R(T::*)(Args...) const>::Matches(lua_State* state, Index<Seq...>)
+    {
+        // The object must be passed as the first argument, optionally followed by fewer arguments
+        int count = lua_gettop(state) - 1;
+        if (count < RequiredArguments<Args...>() || count > static_cast<int>(sizeof...(Args)) || UserdataHeader::Check<T>(state, 1) == nullptr)
+            return false;
 
-        // Create the State needed for calls to C++ code
-        std::shared_ptr<State> luaState(new State(state));
+        return (MatchesType<std::decay_t<Args>>(state, Seq + 2) && ...);
+    }
 
-        // Get the function pointer from the upvalues
-        FuncPtr* func = (FuncPtr*)lua_touserdata(state, lua_upvalueindex(upvalueCount + 1));
-        T* obj = (T*)lua_touserdata(state, 1);
+    template <typename R, typename T, typename... Args>
+    template <typename Target, typename Data, int... Seq>
+    int Function::Callback<R(T::*)(Args...) const>::Invoke(lua_State* state, Index<Seq...>)
+    {
+        // Check we got the correct number of arguments
+        int reqArgs = RequiredArguments<Args...>() - Data::UpvalueCount + 1;
 
-        // Create the tuple of arguments
-        std::tuple<Args...> args;
+        if (lua_gettop(state) < reqArgs)
+            return luaL_error(state, "Not enough arguments, expected %d got %d.", reqArgs, lua_gettop(state));
 
-        // Get the upvalues
-        auto upvalueArgs = Template::Split<0, sizeof...(Upvalues)>(Template::Tie(args));
-        try
-        {
-            StackHelper::GetUpvalues(luaState, upvalueArgs);
-        }
-        catch (LuaException& e)
+        // Borrow the State needed for calls to C++ code
+        StateView luaState(state);
+
+        // Get the function pointer to call, and any upvalues stored alongside it
+        Data* data = static_cast<Data*>(lua_touserdata(state, lua_upvalueindex(1)));
+        FuncPtr func = Target::Get(data);
+        const T* obj = UserdataHeader::Check<T>(state, 1);
+        if (obj == nullptr)
+            return luaL_error(state, "Argument 1 is not the expected userdata type.");
+
+        // Each argument is taken by reference from the upvalues, or constructed directly from its stack slot
+        auto call = [&]() -> R
         {
-            return luaL_error(state, "%s", e.what());
-        }
+            return (obj->*func)(Argument<Seq, Args>(luaState, data, 2)...);
+        };
 
-        // Get the arguments from the stack
-        auto stackArgs = Template::Split<sizeof...(Upvalues), sizeof...(Args)-sizeof...(Upvalues)>(Template::Tie(args));
+        // Call the callback handler
         try
         {
-            StackHelper::GetStack(luaState, stackArgs);
+            return Handler<R, decltype(call)>::Call(luaState, call);
         }
-        catch (LuaException& e)
+        catch (const LuaException& e)
         {
             return luaL_error(state, "%s", e.what());
         }
-
-        // Call the callback handler
-        try
-        {
-            return Handler<FuncPtr>::Call(luaState, *func, obj, Template::ConstTie(args));
-        }
         catch (const std::exception& e)
         {
             return luaL_error(state, "Exception during execution: %s", e.what());
@@ -179,60 +361,91 @@ namespace LuaConnect
     }
 
     template <typename R, typename T, typename... Args>
-    template <int... Seq>
-    R Function::Callback<R(T::*)(Args...) const>::PerformCallback(FuncPtr func, const T* obj, std::tuple<const Args&...> args, Index<Seq...>)
+    bool Function::Callback<R(T::*)(Args...) const>::Matches(lua_State* state)
     {
-        return (obj->*func)(std::get<Seq>(args)...);
+        return Matches(state, GenSequence<sizeof...(Args)>{});
     }
 
     template <typename R, typename T, typename... Args>
     template <typename... Upvalues>
     int Function::Callback<R(T::*)(Args...) const>::Call(lua_State* state)
     {
-        // Check we got the correct number of arguments
-        int reqArgs = static_cast<int>(sizeof...(Args));
-        int upvalueCount = static_cast<int>(sizeof...(Upvalues));
+        using Data = ClosureData<FuncPtr, Upvalues...>;
+        return Invoke<StoredTarget<FuncPtr>, Data>(state, GenSequence<sizeof...(Args)>{});
+    }
+    template <typename R, typename T, typename... Args>
+    template <R(T::*Func)(Args...) const, typename... Upvalues>
+    int Function::Callback<R(T::*)(Args...) const>::CallBound(lua_State* state)
+    {
+        using Data = ClosureData<None, Upvalues...>;
+        return Invoke<BoundTarget<FuncPtr, Func>, Data>(state, GenSequence<sizeof...(Args)>{});
+    }
+    template <typename R, typename T, typename... Args>
+    template <typename Target, typename Data>
+    int Function::Callback<R(T::*)(Args...) const>::CallOverload(lua_State* state)
+    {
+        return Invoke<Target, Data>(state, GenSequence<sizeof...(Args)>{});
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Function::Overloaded - Public Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    template <typename... Fs>
+    template <int... Seq>
+    int Function::Overloaded<Fs...>::Dispatch(lua_State* state, Index<Seq...>)
+    {
+        using Data = ClosureData<std::tuple<Fs...>>;
 
-        if (lua_gettop(state) < reqArgs - upvalueCount + 1)
-            return luaL_error(state, "Not enough arguments, expected %d got %d.", reqArgs - upvalueCount + 1, lua_gettop(state));
+        int results = 0;
 
-        // Create the State needed for calls to C++ code
-        std::shared_ptr<State> luaState(new State(state));
+        // Overloads are checked in the order given, calling the first whose signature matches
+        bool matched = ((Callback<Fs>::Matches(state) && (results = Callback<Fs>::template CallOverload<OverloadTarget<Seq>, Data>(state), true)) || ...);
+        if (!matched)
+            return luaL_error(state, "No overload matches the %d arguments given.", lua_gettop(state));
 
-        // Get the function pointer from the upvalues
-        FuncPtr* func = (FuncPtr*)lua_touserdata(state, lua_upvalueindex(upvalueCount + 1));
-        const T* obj = (const T*)lua_touserdata(state, 1);
+        return results;
+    }
 
-        // Create the tuple of arguments
-        std::tuple<Args...> args;
+    template <typename... Fs>
+    int Function::Overloaded<Fs...>::Call(lua_State* state)
+    {
+        return Dispatch(state, GenSequence<sizeof...(Fs)>{});
+    }
 
-        // Get the upvalues
-        auto upvalueArgs = Template::Split<0, sizeof...(Upvalues)>(Template::Tie(args));
-        try
-        {
-            StackHelper::GetUpvalues(luaState, upvalueArgs);
-        }
-        catch (LuaException& e)
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Function::Closure - Private Static Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    template <typename F, typename R, typename C, typename... Args>
+    template <typename Data, int... Seq>
+    int Function::Closure<F, R(C::*)(Args...)>::Invoke(lua_State* state, Index<Seq...>)
+    {
+        // Check we got the correct number of arguments
+        int reqArgs = RequiredArguments<Args...>() - Data::UpvalueCount;
+
+        if (lua_gettop(state) < reqArgs)
+            return luaL_error(state, "Not enough arguments, expected %d got %d.", reqArgs, lua_gettop(state));
+
+        // Borrow the State needed for calls to C++ code
+        StateView luaState(state);
+
+        // The closure object is stored with its upvalues
+        Data* data = static_cast<Data*>(lua_touserdata(state, lua_upvalueindex(1)));
+
+        // Each argument is taken by reference from the upvalues, or constructed directly from its stack slot
+        auto call = [&]() -> R
         {
-            return luaL_error(state, "%s", e.what());
-        }
+            return data->func(Argument<Seq, Args>(luaState, data, 1)...);
+        };
 
-        // Get the arguments from the stack
-        auto stackArgs = Template::Split<sizeof...(Upvalues), sizeof...(Args)-sizeof...(Upvalues)>(Template::Tie(args));
+        // Call the callback handler
         try
         {
-            StackHelper::GetStack(luaState, stackArgs);
+            return Handler<R, decltype(call)>::Call(luaState, call);
         }
-        catch (LuaException& e)
+        catch (const LuaException& e)
         {
             return luaL_error(state, "%s", e.what());
         }
-
-        // Call the callback handler
-        try
-        {
-            return Handler<FuncPtr>::Call(luaState, *func, obj, Template::ConstTie(args));
-        }
         catch (const std::exception& e)
         {
             return luaL_error(state, "Exception during execution: %s", e.what());
@@ -244,50 +457,29 @@ namespace LuaConnect
     }
 
     ///////////////////////////////////////////////////////////////////////////////////////////////
-    /// Function::Handler - Public Members
+    /// Function::Closure - Public Static Members
     ///////////////////////////////////////////////////////////////////////////////////////////////
-    template <typename R, typename... Args>
-    int Function::Handler<R(*)(Args...)>::Call(std::shared_ptr<State> state, FuncPtr func, std::tuple<const Args&...> args)
-    {
-        R result = Callback<FuncPtr>::PerformCallback(func, args, GenSequence<sizeof...(Args)>{});
-        Stack<R>::Push(state, result);
-
-        return 1;
-    }
-    template <typename... Args>
-    int Function::Handler<void(*)(Args...)>::Call(std::shared_ptr<State> state, FuncPtr func, std::tuple<const Args&...> args)
-    {
-        Callback<FuncPtr>::PerformCallback(func, args, GenSequence<sizeof...(Args)>{});
-
-        return 0;
-    }
-    template <typename T, typename R, typename... Args>
-    int Function::Handler<R(T::*)(Args...)>::Call(std::shared_ptr<State> state, FuncPtr func, T* obj, std::tuple<const Args&...> args)
+    template <typename F, typename R, typename C, typename... Args>
+    template <typename... Upvalues>
+    int Function::Closure<F, R(C::*)(Args...)>::Call(lua_State* state)
     {
-        R result = Callback<FuncPtr>::PerformCallback(func, obj, args, GenSequence<sizeof...(Args)>{});
-        Stack<R>::Push(state, result);
-
-        return 1;
+        return Invoke<ClosureData<F, Upvalues...>>(state, GenSequence<sizeof...(Args)>{});
     }
-    template <typename T, typename... Args>
-    int Function::Handler<void(T::*)(Args...)>::Call(std::shared_ptr<State> state, FuncPtr func, T* obj, std::tuple<const Args&...> args)
-    {
-        Callback<FuncPtr>::PerformCallback(func, obj, args, GenSequence<sizeof...(Args)>{});
 
-        return 0;
-    }
-    template <typename T, typename R, typename... Args>
-    int Function::Handler<R(T::*)(Args...) const>::Call(std::shared_ptr<State> state, FuncPtr func, const T* obj, std::tuple<const Args&...> args)
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Function::Handler - Public Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    template <typename R, typename F>
+    int Function::Handler<R, F>::Call(StateView state, const F& call)
     {
-        R result = Callback<FuncPtr>::PerformCallback(func, obj, args, GenSequence<sizeof...(Args)>{});
-        Stack<R>::Push(state, result);
+        Stack<R>::Push(state, call());
 
-        return 1;
+        return StackSize<R>::value;
     }
-    template <typename T, typename... Args>
-    int Function::Handler<void(T::*)(Args...) const>::Call(std::shared_ptr<State> state, FuncPtr func, const T* obj, std::tuple<const Args&...> args)
+    template <typename F>
+    int Function::Handler<void, F>::Call(StateView state, const F& call)
     {
-        Callback<FuncPtr>::PerformCallback(func, obj, args, GenSequence<sizeof...(Args)>{});
+        call();
 
         return 0;
     }
@@ -300,15 +492,48 @@ namespace LuaConnect
     {
         Balance b(vm.m_state, 0);
 
-        // Push other upvalues onto the stack
-        StackHelper::Push(vm.m_state, std::tuple<const Upvalues&...>(upvalues...));
+        // Store the function with native copies of the upvalues (on the stack)
+        ClosureData<F, Upvalues...>::Push(vm.m_state, std::move(func), upvalues...);
 
-        // Create a copy of the function pointer as a lua userdata (on the stack)
-        F* fp = (F*)lua_newuserdata(vm.m_state->state, sizeof(F));
-        new (fp)F(func);
+        // Create the C closure, lambdas, functors and std::function are called in place
+        if constexpr (std::is_class<F>::value)
+            lua_pushcclosure(vm.m_state.state, &Closure<F>::template Call<Upvalues...>, 1);
+        else
+            lua_pushcclosure(vm.m_state.state, &Callback<F>::template Call<Upvalues...>, 1);
 
-        // Create the C closure, binding the upvalues with it
-        lua_pushcclosure(vm.m_state->state, &Callback<F>::Call<Upvalues...>, sizeof...(Upvalues)+1);
+        return Function(vm.m_state);
+    }
+    template <auto F, typename... Upvalues>
+    Function Function::CreateFunction(VM& vm, const Upvalues&... upvalues)
+    {
+        Balance b(vm.m_state, 0);
+
+        // The function is part of the callback's type, without upvalues this is a light C function
+        if constexpr (sizeof...(Upvalues) == 0)
+        {
+            lua_pushcclosure(vm.m_state.state, &Callback<decltype(F)>::template CallBound<F>, 0);
+        }
+        else
+        {
+            ClosureData<None, Upvalues...>::Push(vm.m_state, None(), upvalues...);
+            lua_pushcclosure(vm.m_state.state, &Callback<decltype(F)>::template CallBound<F, Upvalues...>, 1);
+        }
+
+        return Function(vm.m_state);
+    }
+
+    template <typename... Fs>
+    Function Function::CreateOverloaded(VM& vm, Fs... funcs)
+    {
+        static_assert(sizeof...(Fs) > 0, "At least one overload is required.");
+
+        Balance b(vm.m_state, 0);
+
+        // Store every function pointer in a single userdata (on the stack)
+        ClosureData<std::tuple<Fs...>>::Push(vm.m_state, std::tuple<Fs...>(funcs...));
+
+        // Create the C closure, which dispatches on the types of its arguments
+        lua_pushcclosure(vm.m_state.state, &Overloaded<Fs...>::Call, 1);
 
         return Function(vm.m_state);
     }
@@ -316,21 +541,75 @@ namespace LuaConnect
     ///////////////////////////////////////////////////////////////////////////////////////////////
     /// Function - Private Members
     ///////////////////////////////////////////////////////////////////////////////////////////////
+    template <int I, typename Arg, typename Data>
+    decltype(auto) Function::Argument(StateView state, Data* data, int first)
+    {
+        // Upvalues are bound first and passed by reference, the remaining arguments follow on from the first stack slot
+        if constexpr (I < Data::UpvalueCount)
+            return (std::get<I>(data->upvalues));
+        else
+            return Stack<std::decay_t<Arg>>::Get(state, I - Data::UpvalueCount + first);
+    }
+
     template <typename... Args>
-    void Function::PerformCall(std::tuple<const Args&...> args)
+    constexpr int Function::RequiredArguments()
     {
-        Balance b(m_state, 1);
+        // Trailing optional arguments may be left out by the caller
+        constexpr bool optional[] = { false, StackOptional<std::decay_t<Args>>::value... };
 
-        Ref::Push();
-        StackHelper::Push(m_state, args);
+        int count = static_cast<int>(sizeof...(Args));
+        while (count > 0 && optional[count])
+            --count;
 
-        int err = lua_pcall(m_state->state, std::tuple_size<decltype(args)>::value, 1, 0);
-        if (err != LUA_OK)
+        return count;
+    }
+
+    template <typename T>
+    bool Function::MatchesType(lua_State* state, int index)
+    {
+        // Arguments which were left out can only be optional ones
+        if (index > lua_gettop(state))
+            return StackOptional<T>::value;
+
+        // Registered types must be userdata of that type (or one derived from it)
+        if constexpr (StackUserdata<T>::value)
+            return (UserdataHeader::Check<T>(state, index) != nullptr);
+
+        // Pointers and userdata handles must refer to that type as well, pointers also accept nil
+        using U = typename StackUserdataType<T>::Type;
+        if constexpr (!std::is_void<U>::value)
+            return ((std::is_pointer<T>::value && lua_isnil(state, index)) || UserdataHeader::Check<U>(state, index) != nullptr);
+
+        // Types without a fixed Lua type accept any value
+        if (StackType<T>::value == LUA_TNONE)
+            return true;
+
+        if (lua_type(state, index) != StackType<T>::value)
+            return false;
+
+        // Integers only accept numbers without a fractional part, so they can be overloaded with floats
+        if (std::is_integral<T>::value && StackType<T>::value == LUA_TNUMBER)
         {
-            std::string errStr = Stack<std::string>::Pop(m_state);
+            lua_Number number = lua_tonumber(state, index);
+            return number == std::floor(number);
+        }
 
-            // Push nil to balance stack
-            Stack<Nil>::Push(m_state);
+        return true;
+    }
+
+    template <typename... Args>
+    int Function::PerformCall(StateView state, int results, std::tuple<const Args&...> args)
+    {
+        // The function to call has already been pushed by the caller
+        int top = lua_gettop(state.state) - 1;
+
+        StackHelper::Push(state, args);
+
+        int err = lua_pcall(state.state, std::tuple_size<decltype(args)>::value, results, 0);
+        if (err != LUA_OK)
+        {
+            // Leave the stack as it was before the call
+            std::string errStr = Stack<std::string>::Pop(state);
 
             switch (err)
             {
@@ -344,6 +623,36 @@ namespace LuaConnect
                 throw LuaException("LUA_ERRRUN: " + errStr);
             }
         }
+
+        // With LUA_MULTRET the callee decides how many results were left on the stack
+        return lua_gettop(state.state) - top;
+    }
+    template <typename R, typename... Args>
+    std::vector<R> Function::PerformCallAll(StateView state, const Args&... args)
+    {
+        static_assert(StackOwned<R>::value);
+
+        // Let the callee return as many results as it likes, converting each of them
+        int count = PerformCall(state, LUA_MULTRET, std::forward_as_tuple(args...));
+        int first = lua_gettop(state.state) - count + 1;
+
+        std::vector<R> results;
+        results.reserve(static_cast<std::size_t>(count));
+
+        try
+        {
+            for (int i = 0; i < count; ++i)
+                results.push_back(Stack<R>::Get(state, first + i));
+        }
+        catch (...)
+        {
+            lua_pop(state.state, count);
+            throw;
+        }
+
+        lua_pop(state.state, count);
+
+        return results;
     }
 
     ///////////////////////////////////////////////////////////////////////////////////////////////
@@ -353,6 +662,16 @@ namespace LuaConnect
     R Function::Call(const Args&... args)
     {
         Balance b(m_state, 0);
-        return Function::CallHandler<R, Args...>::Call(*this, args...);
+
+        Ref::Push();
+        return Function::CallHandler<R, Args...>::Call(m_state, args...);
+    }
+    template <typename R, typename... Args>
+    std::vector<R> Function::CallAll(const Args&... args)
+    {
+        Balance b(m_state, 0);
+
+        Ref::Push();
+        return PerformCallAll<R>(m_state, args...);
     }
 }
\ No newline at end of file
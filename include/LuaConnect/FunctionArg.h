@@ -0,0 +1,51 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// LuaConnect/FunctionArg.h
+///////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef LUACONNECT_FUNCTIONARG
+#define LUACONNECT_FUNCTIONARG
+
+#include "Config.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Preprocessor
+///////////////////////////////////////////////////////////////////////////////////////////////////
+#include "Helpers\Slot.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Forward Declarations
+///////////////////////////////////////////////////////////////////////////////////////////////////
+namespace LuaConnect
+{
+    class Function;
+}
+
+namespace LuaConnect
+{
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Class - FunctionArg
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    class LUACONNECT_API FunctionArg : private Slot
+    {
+        template <typename T>
+        friend class Stack;
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    private:
+        FunctionArg(StateView state, int index);
+
+    public:
+        template <typename R, typename... Args>
+        R Call(const Args&... args);
+
+        Function Promote() const;
+    };
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Inline Includes
+///////////////////////////////////////////////////////////////////////////////////////////////////
+#include "FunctionArg.inl"
+
+#endif LUACONNECT_FUNCTIONARG
@@ -0,0 +1,25 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// LuaConnect/FunctionArg.inl
+///////////////////////////////////////////////////////////////////////////////////////////////////
+#include "FunctionArg.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Preprocessor
+///////////////////////////////////////////////////////////////////////////////////////////////////
+#include "Function.h"
+#include "Helpers\Balance.h"
+
+namespace LuaConnect
+{
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// FunctionArg - Public Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    template <typename R, typename... Args>
+    R FunctionArg::Call(const Args&... args)
+    {
+        Balance b(m_state, 0);
+
+        Slot::Push();
+        return Function::CallHandler<R, Args...>::Call(m_state, args...);
+    }
+}
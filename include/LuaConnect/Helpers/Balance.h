@@ -9,15 +9,7 @@
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 /// Preprocessor
 ///////////////////////////////////////////////////////////////////////////////////////////////////
-#include <memory>
-
-///////////////////////////////////////////////////////////////////////////////////////////////////
-/// Forward Declarations
-///////////////////////////////////////////////////////////////////////////////////////////////////
-namespace LuaConnect
-{
-    class State;
-}
+#include "StateView.h"
 
 namespace LuaConnect
 {
@@ -30,13 +22,14 @@ namespace LuaConnect
     /// Members
     ///////////////////////////////////////////////////////////////////////////////////////////////
     private:
-        std::shared_ptr<State> m_state;
+        StateView m_state;
 
         int m_initial;
         int m_delta;
+        int m_exceptions;
 
     public:
-        Balance(std::shared_ptr<State> state, int delta);
+        Balance(StateView state, int delta);
         ~Balance();
     };
 }
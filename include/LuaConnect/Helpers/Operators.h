@@ -0,0 +1,101 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// LuaConnect/Helpers/Operators.h
+///////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef LUACONNECT_HELPERS_OPERATORS
+#define LUACONNECT_HELPERS_OPERATORS
+
+#include "..\Config.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Preprocessor
+///////////////////////////////////////////////////////////////////////////////////////////////////
+#include <type_traits>
+#include <utility>
+
+namespace LuaConnect
+{
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Struct - Operator
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    struct Operator
+    {
+        struct Add
+        {
+            static constexpr const char* Name = "__add";
+
+            template <typename T>
+            static auto Apply(const T& a, const T& b) -> decltype(a + b) { return a + b; }
+        };
+        struct Sub
+        {
+            static constexpr const char* Name = "__sub";
+
+            template <typename T>
+            static auto Apply(const T& a, const T& b) -> decltype(a - b) { return a - b; }
+        };
+        struct Mul
+        {
+            static constexpr const char* Name = "__mul";
+
+            template <typename T>
+            static auto Apply(const T& a, const T& b) -> decltype(a * b) { return a * b; }
+        };
+        struct Div
+        {
+            static constexpr const char* Name = "__div";
+
+            template <typename T>
+            static auto Apply(const T& a, const T& b) -> decltype(a / b) { return a / b; }
+        };
+        struct Eq
+        {
+            static constexpr const char* Name = "__eq";
+
+            template <typename T>
+            static auto Apply(const T& a, const T& b) -> decltype(a == b) { return a == b; }
+        };
+        struct Lt
+        {
+            static constexpr const char* Name = "__lt";
+
+            template <typename T>
+            static auto Apply(const T& a, const T& b) -> decltype(a < b) { return a < b; }
+        };
+        struct Le
+        {
+            static constexpr const char* Name = "__le";
+
+            template <typename T>
+            static auto Apply(const T& a, const T& b) -> decltype(a <= b) { return a <= b; }
+        };
+    };
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Struct - HasOperator
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    template <typename Op, typename T, typename = void>
+    struct HasOperator : std::false_type { };
+
+    template <typename Op, typename T>
+    struct HasOperator<Op, T, std::void_t<decltype(Op::Apply(std::declval<const T&>(), std::declval<const T&>()))>> : std::true_type { };
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Struct - HasCall
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    template <typename T, typename = void>
+    struct HasCall : std::false_type { };
+
+    template <typename T>
+    struct HasCall<T, std::void_t<decltype(&T::operator())>> : std::true_type { };
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Struct - HasSize
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    template <typename T, typename = void>
+    struct HasSize : std::false_type { };
+
+    template <typename T>
+    struct HasSize<T, std::void_t<decltype(std::declval<const T&>().size())>> : std::true_type { };
+}
+
+#endif LUACONNECT_HELPERS_OPERATORS
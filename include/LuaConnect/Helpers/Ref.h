@@ -9,15 +9,7 @@
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 /// Preprocessor
 ///////////////////////////////////////////////////////////////////////////////////////////////////
-#include <memory>
-
-///////////////////////////////////////////////////////////////////////////////////////////////////
-/// Forward Declarations
-///////////////////////////////////////////////////////////////////////////////////////////////////
-namespace LuaConnect
-{
-    class State;
-}
+#include "StateView.h"
 
 namespace LuaConnect
 {
@@ -36,14 +28,15 @@ namespace LuaConnect
         int m_ref;
 
     protected:
-        std::shared_ptr<State> m_state;
+        // Borrowed from the VM, references must not outlive the VM which created them
+        StateView m_state;
 
-        Ref(std::shared_ptr<State> state);
+        Ref(StateView state);
 
         Ref(const Ref& other);
         Ref(Ref&& other);
 
-        virtual ~Ref();
+        ~Ref();
 
         Ref& operator=(const Ref& other);
         Ref& operator=(Ref&& other);
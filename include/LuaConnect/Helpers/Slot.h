@@ -0,0 +1,38 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// LuaConnect/Helpers/Slot.h
+///////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef LUACONNECT_HELPERS_SLOT
+#define LUACONNECT_HELPERS_SLOT
+
+#include "..\Config.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Preprocessor
+///////////////////////////////////////////////////////////////////////////////////////////////////
+#include "StateView.h"
+
+namespace LuaConnect
+{
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Class - Slot
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    class LUACONNECT_API Slot
+    {
+        template <typename T>
+        friend class Stack;
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    protected:
+        // Borrowed from the caller, slots are only valid while the value remains at this index
+        StateView m_state;
+        int m_index;
+
+        Slot(StateView state, int index);
+
+        void Push() const;
+    };
+}
+
+#endif LUACONNECT_HELPERS_SLOT
@@ -10,21 +10,29 @@
 /// Preprocessor
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 #include "Headers.h"
+#include "StateView.h"
+#include "..\BufferView.h"
 #include "..\Function.h"
+#include "..\FunctionArg.h"
+#include "..\Key.h"
+#include "..\Struct.h"
 #include "..\Table.h"
+#include "..\TableArg.h"
 #include "..\Userdata.h"
+#include "..\UserdataArg.h"
 
-#include <memory>
+#include <array>
+#include <map>
+#include <optional>
+#include <set>
 #include <string>
+#include <string_view>
 #include <tuple>
-
-///////////////////////////////////////////////////////////////////////////////////////////////////
-/// Forward Declarations
-///////////////////////////////////////////////////////////////////////////////////////////////////
-namespace LuaConnect
-{
-    class State;
-}
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
 
 namespace LuaConnect
 {
@@ -34,125 +42,328 @@ namespace LuaConnect
     struct LUACONNECT_API Nil;
 
     ///////////////////////////////////////////////////////////////////////////////////////////////
-    /// Class - Stack
+    /// Struct - Checked / Unchecked
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    struct Checked { };
+    struct Unchecked { };
+
     ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Struct - ArithmeticPolicy
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    // Checked conversions throw for values which aren't numbers or don't fit the type, define
+    // LUACONNECT_UNCHECKED_ARITHMETIC (or specialize for a type) to convert without any checks
     template <typename T>
-    class LUACONNECT_API Stack
+    struct ArithmeticPolicy
     {
+#ifdef LUACONNECT_UNCHECKED_ARITHMETIC
+        using type = Unchecked;
+#else
+        using type = Checked;
+#endif
+    };
+
     ///////////////////////////////////////////////////////////////////////////////////////////////
-    /// Members
+    /// Struct - StackSize
     ///////////////////////////////////////////////////////////////////////////////////////////////
-    public:
-        static T Get(std::shared_ptr<State> state, int index);
+    template <typename T>
+    struct StackSize
+    {
+        static const int value = 1;
+    };
+    template <typename... Args>
+    struct StackSize<std::tuple<Args...>>
+    {
+        static const int value = sizeof...(Args);
+    };
+    template <typename A, typename B>
+    struct StackSize<std::pair<A, B>>
+    {
+        static const int value = 2;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Struct - StackOptional
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    struct StackOptional : std::false_type { };
+    template <typename T>
+    struct StackOptional<std::optional<T>> : std::true_type { };
 
-        static T Pop(std::shared_ptr<State> state);
-        static void Push(std::shared_ptr<State> state, T value);
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Struct - StackBorrowed
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    // Types pointing into a Lua string, only valid while it stays on the stack (as callback arguments do)
+    template <typename T>
+    struct StackBorrowed : std::false_type { };
+    template <>
+    struct StackBorrowed<const char*> : std::true_type { };
+    template <>
+    struct StackBorrowed<std::string_view> : std::true_type { };
+    template <typename T>
+    struct StackBorrowed<std::optional<T>> : StackBorrowed<T> { };
+    template <typename... Ts>
+    struct StackBorrowed<std::variant<Ts...>> : std::disjunction<StackBorrowed<Ts>...> { };
+    template <typename... Ts>
+    struct StackBorrowed<std::tuple<Ts...>> : std::disjunction<StackBorrowed<Ts>...> { };
+    template <typename A, typename B>
+    struct StackBorrowed<std::pair<A, B>> : std::disjunction<StackBorrowed<A>, StackBorrowed<B>> { };
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Struct - StackOwned
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    // Checks types which are read and then popped, since nothing keeps their string alive afterwards
+    template <typename... Ts>
+    struct StackOwned
+    {
+        static_assert(!std::disjunction<StackBorrowed<Ts>...>::value, "String views would outlive the value they point into, read a std::string instead.");
+
+        static const bool value = true;
     };
 
     ///////////////////////////////////////////////////////////////////////////////////////////////
-    /// Class - Stack<Nil>
+    /// Struct - StackType
     ///////////////////////////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    struct StackType
+    {
+        // Every arithmetic type is a number and every described struct a table, anything else without a specialization has no fixed type
+        static const int value = (std::is_arithmetic<T>::value ? LUA_TNUMBER : (IsStruct<T>::value ? LUA_TTABLE : LUA_TNONE));
+    };
     template <>
-    class LUACONNECT_API Stack<Nil>
+    struct StackType<Nil>
+    {
+        static const int value = LUA_TNIL;
+    };
+    template <>
+    struct StackType<bool>
+    {
+        static const int value = LUA_TBOOLEAN;
+    };
+    template <>
+    struct StackType<const char*>
+    {
+        static const int value = LUA_TSTRING;
+    };
+    template <>
+    struct StackType<std::string>
+    {
+        static const int value = LUA_TSTRING;
+    };
+    template <>
+    struct StackType<std::string_view>
+    {
+        static const int value = LUA_TSTRING;
+    };
+    template <>
+    struct StackType<Key>
+    {
+        static const int value = LUA_TSTRING;
+    };
+    template <>
+    struct StackType<lua_CFunction>
+    {
+        static const int value = LUA_TFUNCTION;
+    };
+    template <>
+    struct StackType<Function>
+    {
+        static const int value = LUA_TFUNCTION;
+    };
+    template <>
+    struct StackType<Table>
+    {
+        static const int value = LUA_TTABLE;
+    };
+    template <typename T>
+    struct StackType<Userdata<T>>
+    {
+        static const int value = LUA_TUSERDATA;
+    };
+    template <typename T>
+    struct StackType<T*>
+    {
+        static const int value = (std::is_class<T>::value ? LUA_TUSERDATA : LUA_TNONE);
+    };
+    template <>
+    struct StackType<FunctionArg>
+    {
+        static const int value = LUA_TFUNCTION;
+    };
+    template <>
+    struct StackType<TableArg>
+    {
+        static const int value = LUA_TTABLE;
+    };
+    template <typename T>
+    struct StackType<UserdataArg<T>>
+    {
+        static const int value = LUA_TUSERDATA;
+    };
+    template <typename T>
+    struct StackType<BufferView<T>>
+    {
+        static const int value = LUA_TUSERDATA;
+    };
+    template <typename T>
+    struct StackType<std::vector<T>>
+    {
+        static const int value = LUA_TTABLE;
+    };
+    template <typename T, std::size_t N>
+    struct StackType<std::array<T, N>>
+    {
+        static const int value = LUA_TTABLE;
+    };
+    template <typename K, typename V>
+    struct StackType<std::map<K, V>>
+    {
+        static const int value = LUA_TTABLE;
+    };
+    template <typename K, typename V>
+    struct StackType<std::unordered_map<K, V>>
+    {
+        static const int value = LUA_TTABLE;
+    };
+    template <typename T>
+    struct StackType<std::set<T>>
+    {
+        static const int value = LUA_TTABLE;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Class - Stack
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    class LUACONNECT_API Stack
     {
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Static Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    public:
+        // Any class without a specialization is a registered type, held in userdata
+        static const bool IsUserdata = (std::is_class<T>::value && !IsStruct<T>::value);
+
     ///////////////////////////////////////////////////////////////////////////////////////////////
     /// Members
     ///////////////////////////////////////////////////////////////////////////////////////////////
     public:
-        static void Push(std::shared_ptr<State> state);
+        static T Get(StateView state, int index);
+
+        static T Pop(StateView state);
+        static void Push(StateView state, const T& value);
+        static void Push(StateView state, T&& value);
     };
 
     ///////////////////////////////////////////////////////////////////////////////////////////////
-    /// Class - Stack<bool>
+    /// Struct - StackUserdata
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    // Registered types passed by value, only the primary Stack declares IsUserdata
+    template <typename T, typename = void>
+    struct StackUserdata : std::false_type { };
+    template <typename T>
+    struct StackUserdata<T, std::enable_if_t<Stack<T>::IsUserdata>> : std::true_type { };
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Struct - StackUserdataType
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    // Type referenced by a userdata parameter (pointers, Userdata and UserdataArg), void for anything else
+    template <typename T>
+    struct StackUserdataType { using Type = void; };
+    template <typename T>
+    struct StackUserdataType<T*> { using Type = std::conditional_t<std::is_class<T>::value, std::remove_const_t<T>, void>; };
+    template <typename T>
+    struct StackUserdataType<Userdata<T>> { using Type = T; };
+    template <typename T>
+    struct StackUserdataType<UserdataArg<T>> { using Type = T; };
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Class - Stack<Nil>
     ///////////////////////////////////////////////////////////////////////////////////////////////
     template <>
-    class LUACONNECT_API Stack<bool>
+    class LUACONNECT_API Stack<Nil>
     {
     ///////////////////////////////////////////////////////////////////////////////////////////////
     /// Members
     ///////////////////////////////////////////////////////////////////////////////////////////////
     public:
-        static bool Get(std::shared_ptr<State> state, int index);
-
-        static bool Pop(std::shared_ptr<State> state);
-        static void Push(std::shared_ptr<State> state, const bool& value);
+        static void Push(StateView state);
     };
 
     ///////////////////////////////////////////////////////////////////////////////////////////////
-    /// Class - Stack<lua_Integer>
+    /// Class - Stack<bool>
     ///////////////////////////////////////////////////////////////////////////////////////////////
     template <>
-    class LUACONNECT_API Stack<lua_Integer>
+    class LUACONNECT_API Stack<bool>
     {
     ///////////////////////////////////////////////////////////////////////////////////////////////
     /// Members
     ///////////////////////////////////////////////////////////////////////////////////////////////
     public:
-        static lua_Integer Get(std::shared_ptr<State> state, int index);
+        static bool Get(StateView state, int index);
 
-        static lua_Integer Pop(std::shared_ptr<State> state);
-        static void Push(std::shared_ptr<State> state, const lua_Integer& value);
+        static bool Pop(StateView state);
+        static void Push(StateView state, const bool& value);
     };
 
     ///////////////////////////////////////////////////////////////////////////////////////////////
-    /// Class - Stack<lua_Unsigned>
+    /// Class - Stack<const char*>
     ///////////////////////////////////////////////////////////////////////////////////////////////
     template <>
-    class LUACONNECT_API Stack<lua_Unsigned>
+    class LUACONNECT_API Stack<const char*>
     {
     ///////////////////////////////////////////////////////////////////////////////////////////////
     /// Members
     ///////////////////////////////////////////////////////////////////////////////////////////////
     public:
-        static lua_Unsigned Get(std::shared_ptr<State> state, int index);
+        // Points straight into the Lua string, only valid while the value remains on the stack
+        static const char* Get(StateView state, int index);
 
-        static lua_Unsigned Pop(std::shared_ptr<State> state);
-        static void Push(std::shared_ptr<State> state, const lua_Unsigned& value);
+        static void Push(StateView state, const char* value);
     };
 
     ///////////////////////////////////////////////////////////////////////////////////////////////
-    /// Class - Stack<lua_Number>
+    /// Class - Stack<std::string>
     ///////////////////////////////////////////////////////////////////////////////////////////////
     template <>
-    class LUACONNECT_API Stack<lua_Number>
+    class LUACONNECT_API Stack<std::string>
     {
     ///////////////////////////////////////////////////////////////////////////////////////////////
     /// Members
     ///////////////////////////////////////////////////////////////////////////////////////////////
     public:
-        static lua_Number Get(std::shared_ptr<State> state, int index);
+        static std::string Get(StateView state, int index);
 
-        static lua_Number Pop(std::shared_ptr<State> state);
-        static void Push(std::shared_ptr<State> state, const lua_Number& value);
+        static std::string Pop(StateView state);
+        static void Push(StateView state, const std::string& value);
     };
 
     ///////////////////////////////////////////////////////////////////////////////////////////////
-    /// Class - Stack<const char*>
+    /// Class - Stack<std::string_view>
     ///////////////////////////////////////////////////////////////////////////////////////////////
     template <>
-    class LUACONNECT_API Stack<const char*>
+    class LUACONNECT_API Stack<std::string_view>
     {
     ///////////////////////////////////////////////////////////////////////////////////////////////
     /// Members
     ///////////////////////////////////////////////////////////////////////////////////////////////
     public:
-        static void Push(std::shared_ptr<State> state, const char* value);
+        // Points straight into the Lua string, only valid while the value remains on the stack
+        static std::string_view Get(StateView state, int index);
+
+        static void Push(StateView state, const std::string_view& value);
     };
 
     ///////////////////////////////////////////////////////////////////////////////////////////////
-    /// Class - Stack<std::string>
+    /// Class - Stack<Key>
     ///////////////////////////////////////////////////////////////////////////////////////////////
     template <>
-    class LUACONNECT_API Stack<std::string>
+    class LUACONNECT_API Stack<Key>
     {
     ///////////////////////////////////////////////////////////////////////////////////////////////
     /// Members
     ///////////////////////////////////////////////////////////////////////////////////////////////
     public:
-        static std::string Get(std::shared_ptr<State> state, int index);
-
-        static std::string Pop(std::shared_ptr<State> state);
-        static void Push(std::shared_ptr<State> state, const std::string& value);
+        static void Push(StateView state, const Key& value);
     };
 
     ///////////////////////////////////////////////////////////////////////////////////////////////
@@ -165,10 +376,10 @@ namespace LuaConnect
     /// Members
     ///////////////////////////////////////////////////////////////////////////////////////////////
     public:
-        static lua_CFunction Get(std::shared_ptr<State> state, int index);
+        static lua_CFunction Get(StateView state, int index);
 
-        static lua_CFunction Pop(std::shared_ptr<State> state);
-        static void Push(std::shared_ptr<State> state, const lua_CFunction& value, int upvalueCount = 0);
+        static lua_CFunction Pop(StateView state);
+        static void Push(StateView state, const lua_CFunction& value, int upvalueCount = 0);
     };
 
     ///////////////////////////////////////////////////////////////////////////////////////////////
@@ -181,10 +392,10 @@ namespace LuaConnect
     /// Members
     ///////////////////////////////////////////////////////////////////////////////////////////////
     public:
-        static Function Get(std::shared_ptr<State> state, int index);
+        static Function Get(StateView state, int index);
 
-        static Function Pop(std::shared_ptr<State> state);
-        static void Push(std::shared_ptr<State> state, const Function& value);
+        static Function Pop(StateView state);
+        static void Push(StateView state, const Function& value);
     };
 
     ///////////////////////////////////////////////////////////////////////////////////////////////
@@ -197,10 +408,10 @@ namespace LuaConnect
     /// Members
     ///////////////////////////////////////////////////////////////////////////////////////////////
     public:
-        static Table Get(std::shared_ptr<State> state, int index);
+        static Table Get(StateView state, int index);
 
-        static Table Pop(std::shared_ptr<State> state);
-        static void Push(std::shared_ptr<State> state, const Table& value);
+        static Table Pop(StateView state);
+        static void Push(StateView state, const Table& value);
     };
 
     ///////////////////////////////////////////////////////////////////////////////////////////////
@@ -213,7 +424,16 @@ namespace LuaConnect
     /// Members
     ///////////////////////////////////////////////////////////////////////////////////////////////
     public:
-        static void Push(std::shared_ptr<State> state, const char(&value)[N]);
+        static void Push(StateView state, const char(&value)[N]);
+    };
+    template <std::size_t N>
+    class LUACONNECT_API Stack<char[N]>
+    {
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    public:
+        static void Push(StateView state, const char(&value)[N]);
     };
 
     ///////////////////////////////////////////////////////////////////////////////////////////////
@@ -226,10 +446,271 @@ namespace LuaConnect
     /// Members
     ///////////////////////////////////////////////////////////////////////////////////////////////
     public:
-        static Userdata<T> Get(std::shared_ptr<State> state, int index);
+        static Userdata<T> Get(StateView state, int index);
 
-        static Userdata<T> Pop(std::shared_ptr<State> state);
-        static void Push(std::shared_ptr<State> state, const Userdata<T>& value);
+        static Userdata<T> Pop(StateView state);
+        static void Push(StateView state, const Userdata<T>& value);
+    };
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Class - Stack<T*>
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    class LUACONNECT_API Stack<T*>
+    {
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    public:
+        static T* Get(StateView state, int index);
+
+        static T* Pop(StateView state);
+        static void Push(StateView state, T* value);
+    };
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Class - Stack<FunctionArg>
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    template <>
+    class LUACONNECT_API Stack<FunctionArg>
+    {
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    public:
+        static FunctionArg Get(StateView state, int index);
+
+        static void Push(StateView state, const FunctionArg& value);
+    };
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Class - Stack<TableArg>
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    template <>
+    class LUACONNECT_API Stack<TableArg>
+    {
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    public:
+        static TableArg Get(StateView state, int index);
+
+        static void Push(StateView state, const TableArg& value);
+    };
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Class - Stack<UserdataArg>
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    class LUACONNECT_API Stack<UserdataArg<T>>
+    {
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    public:
+        static UserdataArg<T> Get(StateView state, int index);
+
+        static void Push(StateView state, const UserdataArg<T>& value);
+    };
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Class - Stack<BufferView<T>>
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    class LUACONNECT_API Stack<BufferView<T>>
+    {
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    public:
+        static void Push(StateView state, const BufferView<T>& value);
+    };
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Class - Stack<std::tuple<Args...>>
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    template <typename... Args>
+    class LUACONNECT_API Stack<std::tuple<Args...>>
+    {
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    private:
+        template <int... Seq>
+        static std::tuple<Args...> GetIndex(StateView state, int index, Index<Seq...>);
+        template <int... Seq>
+        static void PushIndex(StateView state, const std::tuple<Args...>& value, Index<Seq...>);
+
+    public:
+        static std::tuple<Args...> Get(StateView state, int index);
+
+        static std::tuple<Args...> Pop(StateView state);
+        static void Push(StateView state, const std::tuple<Args...>& value);
+    };
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Class - Stack<std::pair<A, B>>
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    template <typename A, typename B>
+    class LUACONNECT_API Stack<std::pair<A, B>>
+    {
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    public:
+        static std::pair<A, B> Get(StateView state, int index);
+
+        static std::pair<A, B> Pop(StateView state);
+        static void Push(StateView state, const std::pair<A, B>& value);
+    };
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Class - StackStruct
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    class LUACONNECT_API StackStruct
+    {
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Static Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    private:
+        static unsigned char s_key;
+
+        static const int FieldCount = static_cast<int>(std::tuple_size<std::decay_t<decltype(StructFields<T>::fields)>>::value);
+
+        static void PushKeys(StateView state);
+
+    public:
+        static T Get(StateView state, int index);
+        static void Push(StateView state, const T& value);
+    };
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Class - Stack<std::vector<T>>
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    class LUACONNECT_API Stack<std::vector<T>>
+    {
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    public:
+        static std::vector<T> Get(StateView state, int index);
+
+        static std::vector<T> Pop(StateView state);
+        static void Push(StateView state, const std::vector<T>& value);
+    };
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Class - Stack<std::array<T, N>>
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    template <typename T, std::size_t N>
+    class LUACONNECT_API Stack<std::array<T, N>>
+    {
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    public:
+        static std::array<T, N> Get(StateView state, int index);
+
+        static std::array<T, N> Pop(StateView state);
+        static void Push(StateView state, const std::array<T, N>& value);
+    };
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Class - StackMap
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    template <typename M>
+    class LUACONNECT_API StackMap
+    {
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    public:
+        static M Get(StateView state, int index);
+
+        static M Pop(StateView state);
+        static void Push(StateView state, const M& value);
+    };
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Class - Stack<std::map<K, V>>
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    template <typename K, typename V>
+    class LUACONNECT_API Stack<std::map<K, V>> : public StackMap<std::map<K, V>>
+    { };
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Class - Stack<std::unordered_map<K, V>>
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    template <typename K, typename V>
+    class LUACONNECT_API Stack<std::unordered_map<K, V>> : public StackMap<std::unordered_map<K, V>>
+    { };
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Class - Stack<std::set<T>>
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    class LUACONNECT_API Stack<std::set<T>>
+    {
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    public:
+        static std::set<T> Get(StateView state, int index);
+
+        static std::set<T> Pop(StateView state);
+        static void Push(StateView state, const std::set<T>& value);
+    };
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Class - Stack<std::optional<T>>
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    class LUACONNECT_API Stack<std::optional<T>>
+    {
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    public:
+        static std::optional<T> Get(StateView state, int index);
+
+        static std::optional<T> Pop(StateView state);
+        static void Push(StateView state, const std::optional<T>& value);
+    };
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Class - Stack<std::variant<Ts...>>
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    template <typename... Ts>
+    class LUACONNECT_API Stack<std::variant<Ts...>>
+    {
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    private:
+        using Getter = std::variant<Ts...>(*)(StateView state, int index);
+
+        template <typename Predicate>
+        static constexpr int Find(Predicate predicate);
+
+        template <int I>
+        static std::variant<Ts...> GetAlternative(StateView state, int index);
+        template <int I>
+        static bool MatchesUserdata(StateView state, int index);
+        template <int... Seq>
+        static std::variant<Ts...> GetUserdata(StateView state, int index, Index<Seq...>);
+        static std::variant<Ts...> GetUserdata(StateView state, int index);
+        template <int Type>
+        static constexpr Getter GetterFor();
+        template <int... Seq>
+        static const Getter* Getters(Index<Seq...>);
+
+    public:
+        static std::variant<Ts...> Get(StateView state, int index);
+
+        static std::variant<Ts...> Pop(StateView state);
+        static void Push(StateView state, const std::variant<Ts...>& value);
     };
 
     ///////////////////////////////////////////////////////////////////////////////////////////////
@@ -247,8 +728,8 @@ namespace LuaConnect
         template <int N, typename... Args>
         struct StackPusher
         {
-            static void PushIndex(std::shared_ptr<State> state, std::tuple<const Args&...> args);
-            static void PushRecursive(std::shared_ptr<State> state, std::tuple<const Args&...> args);
+            static void PushIndex(StateView state, std::tuple<const Args&...> args);
+            static void PushRecursive(StateView state, std::tuple<const Args&...> args);
         };
 
         ///////////////////////////////////////////////////////////////////////////////////////////
@@ -257,48 +738,8 @@ namespace LuaConnect
         template <typename... Args>
         struct StackPusher<0, Args...>
         {
-            static void PushIndex(std::shared_ptr<State> state, std::tuple<const Args&...> args) { }
-            static void PushRecursive(std::shared_ptr<State> state, std::tuple<const Args&...> args) { }
-        };
-
-        ///////////////////////////////////////////////////////////////////////////////////////////
-        /// Class - StackRetriever
-        ///////////////////////////////////////////////////////////////////////////////////////////
-        template <int N, typename... Args>
-        struct StackRetriever
-        {
-            static void GetIndex(std::shared_ptr<State> state, std::tuple<Args&...> args);
-            static void GetRecursive(std::shared_ptr<State> state, std::tuple<Args&...> args);
-        };
-
-        ///////////////////////////////////////////////////////////////////////////////////////////
-        /// Class - StackRetriever<0, Args...>
-        ///////////////////////////////////////////////////////////////////////////////////////////
-        template <typename... Args>
-        struct StackRetriever<0, Args...>
-        {
-            static void GetIndex(std::shared_ptr<State> state, std::tuple<Args&...> args) { }
-            static void GetRecursive(std::shared_ptr<State> state, std::tuple<Args&...> args) { }
-        };
-
-        ///////////////////////////////////////////////////////////////////////////////////////////
-        /// Class - UpvalueRetriever
-        ///////////////////////////////////////////////////////////////////////////////////////////
-        template <int N, typename... Args>
-        struct UpvalueRetriever
-        {
-            static void GetIndex(std::shared_ptr<State> state, std::tuple<Args&...> args);
-            static void GetRecursive(std::shared_ptr<State> state, std::tuple<Args&...> args);
-        };
-
-        ///////////////////////////////////////////////////////////////////////////////////////////
-        /// Class - UpvalueRetriever<0, Args...>
-        ///////////////////////////////////////////////////////////////////////////////////////////
-        template <typename... Args>
-        struct UpvalueRetriever<0, Args...>
-        {
-            static void GetIndex(std::shared_ptr<State> state, std::tuple<Args&...> args) { }
-            static void GetRecursive(std::shared_ptr<State> state, std::tuple<Args&...> args) { }
+            static void PushIndex(StateView state, std::tuple<const Args&...> args) { }
+            static void PushRecursive(StateView state, std::tuple<const Args&...> args) { }
         };
 
     ///////////////////////////////////////////////////////////////////////////////////////////////
@@ -306,12 +747,9 @@ namespace LuaConnect
     ///////////////////////////////////////////////////////////////////////////////////////////////
     public:
         template <typename... Args>
-        static void GetStack(std::shared_ptr<State> state, std::tuple<Args&...> args);
-        template <typename... Args>
-        static void GetUpvalues(std::shared_ptr<State> state, std::tuple<Args&...> args);
+        static void Push(StateView state, std::tuple<const Args&...> args);
 
-        template <typename... Args>
-        static void Push(std::shared_ptr<State> state, std::tuple<const Args&...> args);
+        static int CheckTable(StateView state, int index);
     };
 }
 
@@ -6,109 +6,772 @@
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 /// Preprocessor
 ///////////////////////////////////////////////////////////////////////////////////////////////////
-#include "State.h"
 #include "Templates.h"
+#include "UserdataHeader.h"
+#include "..\Exceptions\LuaException.h"
+
+#include <cmath>
+#include <limits>
+#include <string>
 
 namespace LuaConnect
 {
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Stack - Public Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    T Stack<T>::Get(StateView state, int index)
+    {
+        static_assert(std::is_arithmetic<T>::value || std::is_class<T>::value, "Type has no Stack specialization.");
+
+        if constexpr (IsStruct<T>::value)
+        {
+            return StackStruct<T>::Get(state, index);
+        }
+        // Registered types are copied out of their userdata
+        else if constexpr (std::is_class<T>::value)
+        {
+            T* object = Stack<T*>::Get(state, index);
+            if (object == nullptr)
+                throw LuaException("Object at index " + std::to_string(index) + " is nil, expected Userdata.");
+
+            return *object;
+        }
+        // Skip every check, reading through the narrowest API call which fits the type
+        else if constexpr (std::is_same<typename ArithmeticPolicy<T>::type, Unchecked>::value)
+        {
+            if constexpr (std::is_floating_point<T>::value)
+                return static_cast<T>(lua_tonumber(state.state, index));
+            else if constexpr (std::is_signed<T>::value && sizeof(T) <= sizeof(lua_Integer))
+                return static_cast<T>(lua_tointeger(state.state, index));
+            else if constexpr (std::is_unsigned<T>::value && sizeof(T) <= sizeof(lua_Unsigned))
+                return static_cast<T>(lua_tounsigned(state.state, index));
+            else
+                return static_cast<T>(lua_tonumber(state.state, index));
+        }
+        else
+        {
+            int isNumber = 0;
+            lua_Number number = lua_tonumberx(state.state, index, &isNumber);
+
+            if (!isNumber)
+            {
+                std::string name = lua_typename(state.state, lua_type(state.state, index));
+                throw LuaException("Object at index " + std::to_string(index) + " is not a number (is " + name + ").");
+            }
+
+            if constexpr (std::is_integral<T>::value)
+            {
+                // The upper bound is exclusive, as the maximum of a 64 bit integer rounds up as a double
+                if (number != std::floor(number))
+                    throw LuaException("Number at index " + std::to_string(index) + " is not an integer.");
+                if (number < static_cast<lua_Number>(std::numeric_limits<T>::min()) || number >= static_cast<lua_Number>(std::numeric_limits<T>::max()) + 1)
+                    throw LuaException("Number at index " + std::to_string(index) + " is out of range.");
+            }
+            else if constexpr (sizeof(T) < sizeof(lua_Number))
+            {
+                if (std::isfinite(number) && std::fabs(number) > static_cast<lua_Number>(std::numeric_limits<T>::max()))
+                    throw LuaException("Number at index " + std::to_string(index) + " is out of range.");
+            }
+
+            return static_cast<T>(number);
+        }
+    }
+
+    template <typename T>
+    T Stack<T>::Pop(StateView state)
+    {
+        T result = Stack<T>::Get(state, -1);
+        lua_pop(state.state, 1);
+
+        return result;
+    }
+    template <typename T>
+    void Stack<T>::Push(StateView state, const T& value)
+    {
+        static_assert(std::is_arithmetic<T>::value || std::is_class<T>::value, "Type has no Stack specialization.");
+
+        if constexpr (IsStruct<T>::value)
+            StackStruct<T>::Push(state, value);
+        // Any other class is a registered type, copied into new userdata
+        else if constexpr (std::is_class<T>::value)
+            Userdata<T>::PushNew(state, value);
+        // Push through the narrowest API call which fits the type
+        else if constexpr (std::is_floating_point<T>::value)
+            lua_pushnumber(state.state, static_cast<lua_Number>(value));
+        else if constexpr (std::is_signed<T>::value && sizeof(T) <= sizeof(lua_Integer))
+            lua_pushinteger(state.state, static_cast<lua_Integer>(value));
+        else if constexpr (std::is_unsigned<T>::value && sizeof(T) <= sizeof(lua_Unsigned))
+            lua_pushunsigned(state.state, static_cast<lua_Unsigned>(value));
+        else
+            lua_pushnumber(state.state, static_cast<lua_Number>(value));
+    }
+    template <typename T>
+    void Stack<T>::Push(StateView state, T&& value)
+    {
+        // Temporaries of registered types (such as returned values) are moved into the userdata instead of copied
+        if constexpr (std::is_class<T>::value && !IsStruct<T>::value)
+            Userdata<T>::PushNew(state, std::move(value));
+        else
+            Push(state, static_cast<const T&>(value));
+    }
+
     ///////////////////////////////////////////////////////////////////////////////////////////////
     /// Stack<const char[]> - Public Members
     ///////////////////////////////////////////////////////////////////////////////////////////////
     template <std::size_t N>
-    void Stack<const char[N]>::Push(std::shared_ptr<State> state, const char(&value)[N])
+    void Stack<const char[N]>::Push(StateView state, const char(&value)[N])
     {
-        Stack<std::string>::Push(state, std::string(value));
+        lua_pushstring(state.state, value);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Stack<char[]> - Public Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    template <std::size_t N>
+    void Stack<char[N]>::Push(StateView state, const char(&value)[N])
+    {
+        lua_pushstring(state.state, value);
     }
 
     ///////////////////////////////////////////////////////////////////////////////////////////////
     /// Stack<Userdata> - Public Members
     ///////////////////////////////////////////////////////////////////////////////////////////////
     template <typename T>
-    Userdata<T> Stack<Userdata<T>>::Get(std::shared_ptr<State> state, int index)
+    Userdata<T> Stack<Userdata<T>>::Get(StateView state, int index)
     {
-        lua_pushvalue(state->state, index);
+        lua_pushvalue(state.state, index);
         return Userdata<T>(state);
     }
 
     template <typename T>
-    Userdata<T> Stack<Userdata<T>>::Pop(std::shared_ptr<State> state)
+    Userdata<T> Stack<Userdata<T>>::Pop(StateView state)
     {
         Userdata<T> result = Stack<Userdata<T>>::Get(state, -1);
-        lua_pop(state->state, 1);
+        lua_pop(state.state, 1);
 
         return result;
     }
     template <typename T>
-    void Stack<Userdata<T>>::Push(std::shared_ptr<State> state, const Userdata<T>& value)
+    void Stack<Userdata<T>>::Push(StateView state, const Userdata<T>& value)
     {
-        lua_rawgeti(state->state, LUA_REGISTRYINDEX, value.m_ref);
+        lua_rawgeti(state.state, LUA_REGISTRYINDEX, value.m_ref);
     }
 
     ///////////////////////////////////////////////////////////////////////////////////////////////
-    /// StackHelper::StackPusher - Public Members
+    /// Stack<T*> - Public Members
     ///////////////////////////////////////////////////////////////////////////////////////////////
-    template <int N, typename... Args>
-    void StackHelper::StackPusher<N, Args...>::PushIndex(std::shared_ptr<State> state, std::tuple<const Args&...> args)
+    template <typename T>
+    T* Stack<T*>::Get(StateView state, int index)
     {
-        Stack<TypeList<Args...>::At<sizeof...(Args)-N>>::Push(state, std::get<sizeof...(Args)-N>(args));
+        static_assert(std::is_class<T>::value, "Type has no Stack specialization.");
+
+        if (lua_isnil(state.state, index))
+            return nullptr;
+
+        T* result = UserdataHeader::Check<std::remove_const_t<T>>(state.state, index);
+        if (result == nullptr)
+            throw LuaException("Object at index " + std::to_string(index) + " is not Userdata of the expected type.");
+
+        return result;
     }
-    template <int N, typename... Args>
-    void StackHelper::StackPusher<N, Args...>::PushRecursive(std::shared_ptr<State> state, std::tuple<const Args&...> args)
+
+    template <typename T>
+    T* Stack<T*>::Pop(StateView state)
     {
-        StackHelper::StackPusher<N, Args...>::PushIndex(state, args);
-        StackHelper::StackPusher<N - 1, Args...>::PushRecursive(state, args);
+        T* result = Stack<T*>::Get(state, -1);
+        lua_pop(state.state, 1);
+
+        return result;
+    }
+    template <typename T>
+    void Stack<T*>::Push(StateView state, T* value)
+    {
+        static_assert(std::is_class<T>::value, "Type has no Stack specialization.");
+
+        // Pointers become references to the C++ owned object, without taking a registry reference
+        if (value == nullptr)
+            lua_pushnil(state.state);
+        else
+            Userdata<std::remove_const_t<T>>::PushRef(state, const_cast<std::remove_const_t<T>*>(value));
     }
 
     ///////////////////////////////////////////////////////////////////////////////////////////////
-    /// StackHelper::StackRetriever - Public Members
+    /// Stack<UserdataArg> - Public Members
     ///////////////////////////////////////////////////////////////////////////////////////////////
-    template <int N, typename... Args>
-    void StackHelper::StackRetriever<N, Args...>::GetIndex(std::shared_ptr<State> state, std::tuple<Args&...> args)
+    template <typename T>
+    UserdataArg<T> Stack<UserdataArg<T>>::Get(StateView state, int index)
     {
-        const int index = N - ((int)sizeof...(Args)+1);
-        std::get<N - 1>(args) = Stack<TypeList<Args...>::At<N - 1>>::Get(state, index);
+        return UserdataArg<T>(state, index);
     }
-    template <int N, typename... Args>
-    void StackHelper::StackRetriever<N, Args...>::GetRecursive(std::shared_ptr<State> state, std::tuple<Args&...> args)
+
+    template <typename T>
+    void Stack<UserdataArg<T>>::Push(StateView state, const UserdataArg<T>& value)
     {
-        StackHelper::StackRetriever<N, Args...>::GetIndex(state, args);
-        StackHelper::StackRetriever<N - 1, Args...>::GetRecursive(state, args);
+        lua_pushvalue(state.state, value.m_index);
     }
 
     ///////////////////////////////////////////////////////////////////////////////////////////////
-    /// StackHelper::UpvalueRetriever - Public Members
+    /// Stack<BufferView> - Public Members
     ///////////////////////////////////////////////////////////////////////////////////////////////
-    template <int N, typename... Args>
-    void StackHelper::UpvalueRetriever<N, Args...>::GetIndex(std::shared_ptr<State> state, std::tuple<Args&...> args)
+    template <typename T>
+    void Stack<BufferView<T>>::Push(StateView state, const BufferView<T>& value)
     {
-        const int index = lua_upvalueindex(N);
-        std::get<N - 1>(args) = Stack<TypeList<Args...>::At<N - 1>>::Get(state, index);
+        lua_rawgeti(state.state, LUA_REGISTRYINDEX, value.m_ref);
     }
-    template <int N, typename... Args>
-    void StackHelper::UpvalueRetriever<N, Args...>::GetRecursive(std::shared_ptr<State> state, std::tuple<Args&...> args)
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Stack<std::tuple<Args...>> - Private Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    template <typename... Args>
+    template <int... Seq>
+    std::tuple<Args...> Stack<std::tuple<Args...>>::GetIndex(StateView state, int index, Index<Seq...>)
+    {
+        return std::tuple<Args...>{ Stack<Args>::Get(state, index + Seq)... };
+    }
+    template <typename... Args>
+    template <int... Seq>
+    void Stack<std::tuple<Args...>>::PushIndex(StateView state, const std::tuple<Args...>& value, Index<Seq...>)
     {
-        StackHelper::UpvalueRetriever<N, Args...>::GetIndex(state, args);
-        StackHelper::UpvalueRetriever<N - 1, Args...>::GetRecursive(state, args);
+        (Stack<Args>::Push(state, std::get<Seq>(value)), ...);
     }
 
     ///////////////////////////////////////////////////////////////////////////////////////////////
-    /// StackHelper - Public Members
+    /// Stack<std::tuple<Args...>> - Public Members
     ///////////////////////////////////////////////////////////////////////////////////////////////
     template <typename... Args>
-    void StackHelper::GetStack(std::shared_ptr<State> state, std::tuple<Args&...> args)
+    std::tuple<Args...> Stack<std::tuple<Args...>>::Get(StateView state, int index)
+    {
+        // Elements occupy consecutive slots, starting at index
+        return GetIndex(state, index, GenSequence<sizeof...(Args)>{});
+    }
+
+    template <typename... Args>
+    std::tuple<Args...> Stack<std::tuple<Args...>>::Pop(StateView state)
     {
-        Balance b(state, 0);
-        StackHelper::StackRetriever<sizeof...(Args), Args...>::GetRecursive(state, args);
+        const int count = static_cast<int>(sizeof...(Args));
+
+        std::tuple<Args...> result = Stack<std::tuple<Args...>>::Get(state, -count);
+        lua_pop(state.state, count);
+
+        return result;
     }
     template <typename... Args>
-    void StackHelper::GetUpvalues(std::shared_ptr<State> state, std::tuple<Args&...> args)
+    void Stack<std::tuple<Args...>>::Push(StateView state, const std::tuple<Args...>& value)
+    {
+        PushIndex(state, value, GenSequence<sizeof...(Args)>{});
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Stack<std::pair<A, B>> - Public Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    template <typename A, typename B>
+    std::pair<A, B> Stack<std::pair<A, B>>::Get(StateView state, int index)
+    {
+        return std::pair<A, B>(Stack<A>::Get(state, index), Stack<B>::Get(state, index + 1));
+    }
+
+    template <typename A, typename B>
+    std::pair<A, B> Stack<std::pair<A, B>>::Pop(StateView state)
+    {
+        std::pair<A, B> result = Stack<std::pair<A, B>>::Get(state, -2);
+        lua_pop(state.state, 2);
+
+        return result;
+    }
+    template <typename A, typename B>
+    void Stack<std::pair<A, B>>::Push(StateView state, const std::pair<A, B>& value)
+    {
+        Stack<A>::Push(state, value.first);
+        Stack<B>::Push(state, value.second);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// StackStruct - Private Static Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    unsigned char StackStruct<T>::s_key = 0;
+
+    template <typename T>
+    void StackStruct<T>::PushKeys(StateView state)
+    {
+        // Field names are interned once per VM, in an array indexed by field
+        lua_rawgetp(state.state, LUA_REGISTRYINDEX, &s_key);
+        if (!lua_isnil(state.state, -1))
+            return;
+
+        lua_pop(state.state, 1);
+        lua_createtable(state.state, FieldCount, 0);
+
+        int i = 0;
+        std::apply([&](const auto&... fields)
+        {
+            ((lua_pushstring(state.state, fields.name), lua_rawseti(state.state, -2, ++i)), ...);
+        }, StructFields<T>::fields);
+
+        lua_pushvalue(state.state, -1);
+        lua_rawsetp(state.state, LUA_REGISTRYINDEX, &s_key);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// StackStruct - Public Static Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    T StackStruct<T>::Get(StateView state, int index)
+    {
+        index = StackHelper::CheckTable(state, index);
+        int top = lua_gettop(state.state);
+
+        T result{};
+        PushKeys(state);
+
+        // Decode each field straight into the struct
+        try
+        {
+            int i = 0;
+            std::apply([&](const auto&... fields)
+            {
+                static_assert(StackOwned<typename std::decay_t<decltype(fields)>::Type...>::value);
+
+                ((lua_rawgeti(state.state, -1, ++i),
+                  lua_rawget(state.state, index),
+                  result.*(fields.member) = Stack<typename std::decay_t<decltype(fields)>::Type>::Get(state, -1),
+                  lua_pop(state.state, 1)), ...);
+            }, StructFields<T>::fields);
+        }
+        catch (LuaException&)
+        {
+            lua_settop(state.state, top);
+            throw;
+        }
+
+        lua_pop(state.state, 1);
+
+        return result;
+    }
+    template <typename T>
+    void StackStruct<T>::Push(StateView state, const T& value)
+    {
+        // Presize the hash part, then fill it with the interned keys without going through any metamethods
+        lua_createtable(state.state, 0, FieldCount);
+        PushKeys(state);
+
+        int i = 0;
+        std::apply([&](const auto&... fields)
+        {
+            ((lua_rawgeti(state.state, -1, ++i),
+              Stack<typename std::decay_t<decltype(fields)>::Type>::Push(state, value.*(fields.member)),
+              lua_rawset(state.state, -4)), ...);
+        }, StructFields<T>::fields);
+
+        lua_pop(state.state, 1);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Stack<std::vector<T>> - Public Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    std::vector<T> Stack<std::vector<T>>::Get(StateView state, int index)
+    {
+        static_assert(StackOwned<T>::value);
+
+        index = StackHelper::CheckTable(state, index);
+
+        // Size the vector up front, so the elements convert in a single pass
+        std::size_t size = lua_rawlen(state.state, index);
+
+        std::vector<T> result;
+        result.reserve(size);
+
+        // An element failing to convert must not leave itself on the stack
+        int top = lua_gettop(state.state);
+        try
+        {
+            for (std::size_t i = 1; i <= size; ++i)
+            {
+                lua_rawgeti(state.state, index, static_cast<int>(i));
+                result.push_back(Stack<T>::Get(state, -1));
+                lua_pop(state.state, 1);
+            }
+        }
+        catch (LuaException&)
+        {
+            lua_settop(state.state, top);
+            throw;
+        }
+
+        return result;
+    }
+
+    template <typename T>
+    std::vector<T> Stack<std::vector<T>>::Pop(StateView state)
+    {
+        std::vector<T> result = Stack<std::vector<T>>::Get(state, -1);
+        lua_pop(state.state, 1);
+
+        return result;
+    }
+    template <typename T>
+    void Stack<std::vector<T>>::Push(StateView state, const std::vector<T>& value)
     {
-        Balance b(state, 0);
-        StackHelper::UpvalueRetriever<sizeof...(Args), Args...>::GetRecursive(state, args);
+        // Presize the array part, then fill it without going through any metamethods
+        lua_createtable(state.state, static_cast<int>(value.size()), 0);
+
+        for (std::size_t i = 0; i < value.size(); ++i)
+        {
+            Stack<T>::Push(state, value[i]);
+            lua_rawseti(state.state, -2, static_cast<int>(i + 1));
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Stack<std::array<T, N>> - Public Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    template <typename T, std::size_t N>
+    std::array<T, N> Stack<std::array<T, N>>::Get(StateView state, int index)
+    {
+        static_assert(StackOwned<T>::value);
+
+        index = StackHelper::CheckTable(state, index);
+
+        std::size_t size = lua_rawlen(state.state, index);
+        if (size != N)
+            throw LuaException("Table at index " + std::to_string(index) + " has length " + std::to_string(size) + ", expected " + std::to_string(N) + ".");
+
+        std::array<T, N> result{};
+
+        int top = lua_gettop(state.state);
+        try
+        {
+            for (std::size_t i = 0; i < N; ++i)
+            {
+                lua_rawgeti(state.state, index, static_cast<int>(i + 1));
+                result[i] = Stack<T>::Get(state, -1);
+                lua_pop(state.state, 1);
+            }
+        }
+        catch (LuaException&)
+        {
+            lua_settop(state.state, top);
+            throw;
+        }
+
+        return result;
+    }
+
+    template <typename T, std::size_t N>
+    std::array<T, N> Stack<std::array<T, N>>::Pop(StateView state)
+    {
+        std::array<T, N> result = Stack<std::array<T, N>>::Get(state, -1);
+        lua_pop(state.state, 1);
+
+        return result;
+    }
+    template <typename T, std::size_t N>
+    void Stack<std::array<T, N>>::Push(StateView state, const std::array<T, N>& value)
+    {
+        lua_createtable(state.state, static_cast<int>(N), 0);
+
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            Stack<T>::Push(state, value[i]);
+            lua_rawseti(state.state, -2, static_cast<int>(i + 1));
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// StackMap - Public Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    template <typename M>
+    M StackMap<M>::Get(StateView state, int index)
+    {
+        using K = typename M::key_type;
+        using V = typename M::mapped_type;
+
+        static_assert(StackOwned<K, V>::value);
+
+        index = StackHelper::CheckTable(state, index);
+
+        M result;
+
+        // A key or value failing to convert must not leave the iteration on the stack
+        int top = lua_gettop(state.state);
+        try
+        {
+            lua_pushnil(state.state);
+            while (lua_next(state.state, index) != 0)
+            {
+                // Read a copy of the key, converting the key itself in place would confuse lua_next
+                lua_pushvalue(state.state, -2);
+                result.emplace(Stack<K>::Get(state, -1), Stack<V>::Get(state, -2));
+                lua_pop(state.state, 2);
+            }
+        }
+        catch (LuaException&)
+        {
+            lua_settop(state.state, top);
+            throw;
+        }
+
+        return result;
+    }
+
+    template <typename M>
+    M StackMap<M>::Pop(StateView state)
+    {
+        M result = StackMap<M>::Get(state, -1);
+        lua_pop(state.state, 1);
+
+        return result;
+    }
+    template <typename M>
+    void StackMap<M>::Push(StateView state, const M& value)
+    {
+        using K = typename M::key_type;
+        using V = typename M::mapped_type;
+
+        // Presize the hash part, then fill it without going through any metamethods
+        lua_createtable(state.state, 0, static_cast<int>(value.size()));
+
+        for (const auto& pair : value)
+        {
+            Stack<K>::Push(state, pair.first);
+            Stack<V>::Push(state, pair.second);
+            lua_rawset(state.state, -3);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Stack<std::set<T>> - Public Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    std::set<T> Stack<std::set<T>>::Get(StateView state, int index)
+    {
+        static_assert(StackOwned<T>::value);
+
+        index = StackHelper::CheckTable(state, index);
+
+        std::set<T> result;
+
+        // Elements are the keys of the table, read from a copy so lua_next still sees the original
+        int top = lua_gettop(state.state);
+        try
+        {
+            lua_pushnil(state.state);
+            while (lua_next(state.state, index) != 0)
+            {
+                lua_pushvalue(state.state, -2);
+                result.insert(Stack<T>::Get(state, -1));
+                lua_pop(state.state, 2);
+            }
+        }
+        catch (LuaException&)
+        {
+            lua_settop(state.state, top);
+            throw;
+        }
+
+        return result;
+    }
+
+    template <typename T>
+    std::set<T> Stack<std::set<T>>::Pop(StateView state)
+    {
+        std::set<T> result = Stack<std::set<T>>::Get(state, -1);
+        lua_pop(state.state, 1);
+
+        return result;
+    }
+    template <typename T>
+    void Stack<std::set<T>>::Push(StateView state, const std::set<T>& value)
+    {
+        // Each element becomes a key mapping to true
+        lua_createtable(state.state, 0, static_cast<int>(value.size()));
+
+        for (const T& element : value)
+        {
+            Stack<T>::Push(state, element);
+            lua_pushboolean(state.state, 1);
+            lua_rawset(state.state, -3);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Stack<std::optional<T>> - Public Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    std::optional<T> Stack<std::optional<T>>::Get(StateView state, int index)
+    {
+        if (lua_isnoneornil(state.state, index))
+            return std::nullopt;
+
+        return Stack<T>::Get(state, index);
+    }
+
+    template <typename T>
+    std::optional<T> Stack<std::optional<T>>::Pop(StateView state)
+    {
+        std::optional<T> result = Stack<std::optional<T>>::Get(state, -1);
+        lua_pop(state.state, 1);
+
+        return result;
+    }
+    template <typename T>
+    void Stack<std::optional<T>>::Push(StateView state, const std::optional<T>& value)
+    {
+        if (value)
+            Stack<T>::Push(state, *value);
+        else
+            lua_pushnil(state.state);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Stack<std::variant<Ts...>> - Private Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    template <typename... Ts>
+    template <typename Predicate>
+    constexpr int Stack<std::variant<Ts...>>::Find(Predicate predicate)
+    {
+        // Index of the first alternative matching the predicate, or -1 (registered types being userdata)
+        constexpr int types[] = { (StackUserdata<Ts>::value ? LUA_TUSERDATA : StackType<Ts>::value)... };
+        constexpr bool integral[] = { std::is_integral<Ts>::value... };
+
+        for (int i = 0; i < static_cast<int>(sizeof...(Ts)); ++i)
+        {
+            if (predicate(types[i], integral[i]))
+                return i;
+        }
+
+        return -1;
+    }
+
+    template <typename... Ts>
+    template <int I>
+    std::variant<Ts...> Stack<std::variant<Ts...>>::GetAlternative(StateView state, int index)
+    {
+        using T = std::variant_alternative_t<I, std::variant<Ts...>>;
+        return std::variant<Ts...>(std::in_place_index<I>, Stack<T>::Get(state, index));
+    }
+    template <typename... Ts>
+    template <int I>
+    bool Stack<std::variant<Ts...>>::MatchesUserdata(StateView state, int index)
+    {
+        using T = std::variant_alternative_t<I, std::variant<Ts...>>;
+
+        // Registered types must match the header, userdata wrappers check the value themselves
+        if constexpr (StackUserdata<T>::value)
+            return (UserdataHeader::Check<T>(state.state, index) != nullptr);
+        else
+            return (StackType<T>::value == LUA_TUSERDATA);
+    }
+    template <typename... Ts>
+    template <int... Seq>
+    std::variant<Ts...> Stack<std::variant<Ts...>>::GetUserdata(StateView state, int index, Index<Seq...>)
+    {
+        // Several alternatives may be userdata, so take the first one the value matches
+        Getter getter = nullptr;
+        ((getter == nullptr && MatchesUserdata<Seq>(state, index) ? (void)(getter = &GetAlternative<Seq>) : (void)0), ...);
+
+        if (getter == nullptr)
+            throw LuaException("Object at index " + std::to_string(index) + " matches no alternative of the variant (is userdata of another type).");
+
+        return getter(state, index);
+    }
+    template <typename... Ts>
+    std::variant<Ts...> Stack<std::variant<Ts...>>::GetUserdata(StateView state, int index)
+    {
+        return GetUserdata(state, index, GenSequence<sizeof...(Ts)>{});
+    }
+    template <typename... Ts>
+    template <int Type>
+    constexpr typename Stack<std::variant<Ts...>>::Getter Stack<std::variant<Ts...>>::GetterFor()
+    {
+        constexpr int I = Find([](int type, bool) { return type == Type; });
+
+        if constexpr (I < 0)
+            return nullptr;
+        else if constexpr (Type == LUA_TUSERDATA)
+            return static_cast<Getter>(&GetUserdata);
+        else
+            return &GetAlternative<I>;
+    }
+    template <typename... Ts>
+    template <int... Seq>
+    const typename Stack<std::variant<Ts...>>::Getter* Stack<std::variant<Ts...>>::Getters(Index<Seq...>)
+    {
+        // One entry per Lua type, so picking the alternative is a single lookup
+        static const Getter getters[] = { GetterFor<Seq>()... };
+        return getters;
     }
 
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Stack<std::variant<Ts...>> - Public Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    template <typename... Ts>
+    std::variant<Ts...> Stack<std::variant<Ts...>>::Get(StateView state, int index)
+    {
+        int type = lua_type(state.state, index);
+
+        // Whole numbers prefer an integral alternative, when there is also a floating point one
+        constexpr int integral = Find([](int type, bool integral) { return type == LUA_TNUMBER && integral; });
+        constexpr int floating = Find([](int type, bool integral) { return type == LUA_TNUMBER && !integral; });
+
+        if constexpr (integral >= 0 && floating >= 0)
+        {
+            if (type == LUA_TNUMBER)
+            {
+                lua_Number number = lua_tonumber(state.state, index);
+                return (number == std::floor(number) ? GetAlternative<integral>(state, index) : GetAlternative<floating>(state, index));
+            }
+        }
+
+        // Missing values are treated as nil
+        const Getter* getters = Getters(GenSequence<LUA_NUMTAGS>{});
+        Getter getter = getters[type == LUA_TNONE ? LUA_TNIL : type];
+
+        if (getter == nullptr)
+        {
+            std::string name = lua_typename(state.state, type);
+            throw LuaException("Object at index " + std::to_string(index) + " matches no alternative of the variant (is " + name + ").");
+        }
+
+        return getter(state, index);
+    }
+
+    template <typename... Ts>
+    std::variant<Ts...> Stack<std::variant<Ts...>>::Pop(StateView state)
+    {
+        std::variant<Ts...> result = Stack<std::variant<Ts...>>::Get(state, -1);
+        lua_pop(state.state, 1);
+
+        return result;
+    }
+    template <typename... Ts>
+    void Stack<std::variant<Ts...>>::Push(StateView state, const std::variant<Ts...>& value)
+    {
+        std::visit([&](const auto& alternative) { Stack<std::decay_t<decltype(alternative)>>::Push(state, alternative); }, value);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// StackHelper::StackPusher - Public Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    template <int N, typename... Args>
+    void StackHelper::StackPusher<N, Args...>::PushIndex(StateView state, std::tuple<const Args&...> args)
+    {
+        Stack<TypeList<Args...>::At<sizeof...(Args)-N>>::Push(state, std::get<sizeof...(Args)-N>(args));
+    }
+    template <int N, typename... Args>
+    void StackHelper::StackPusher<N, Args...>::PushRecursive(StateView state, std::tuple<const Args&...> args)
+    {
+        StackHelper::StackPusher<N, Args...>::PushIndex(state, args);
+        StackHelper::StackPusher<N - 1, Args...>::PushRecursive(state, args);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// StackHelper - Public Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
     template <typename... Args>
-    void StackHelper::Push(std::shared_ptr<State> state, std::tuple<const Args&...> args)
+    void StackHelper::Push(StateView state, std::tuple<const Args&...> args)
     {
         Balance b(state, (int)sizeof...(Args));
         StackHelper::StackPusher<sizeof...(Args), Args...>::PushRecursive(state, args);
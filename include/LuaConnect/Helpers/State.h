@@ -26,15 +26,10 @@ namespace LuaConnect
     ///////////////////////////////////////////////////////////////////////////////////////////////
     /// Members
     ///////////////////////////////////////////////////////////////////////////////////////////////
-    private:
-        bool m_managed;
-
     public:
         lua_State* state;
 
         State();
-        State(lua_State* state);
-
         ~State();
     };
 }
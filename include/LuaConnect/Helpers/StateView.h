@@ -0,0 +1,32 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// LuaConnect/Helpers/StateView.h
+///////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef LUACONNECT_HELPERS_STATEVIEW
+#define LUACONNECT_HELPERS_STATEVIEW
+
+#include "..\Config.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Forward Declarations
+///////////////////////////////////////////////////////////////////////////////////////////////////
+struct lua_State;
+
+namespace LuaConnect
+{
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Class - StateView
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    class LUACONNECT_API StateView
+    {
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    public:
+        lua_State* state;
+
+        StateView() : state(nullptr) { }
+        StateView(lua_State* state) : state(state) { }
+    };
+}
+
+#endif LUACONNECT_HELPERS_STATEVIEW
\ No newline at end of file
@@ -92,46 +92,17 @@ namespace LuaConnect
     /// Members
     ///////////////////////////////////////////////////////////////////////////////////////////////
     private:
-        template <typename... Args, int... Seq>
-        static std::tuple<Args&...> MakeTie(std::tuple<Args...>& args, Index<Seq...>)
-        {
-            return std::tie(std::get<Seq>(args)...);
-        }
-
-        template <typename... Args, int... Seq>
-        static auto DoSplit(std::tuple<Args&...> args, Index<Seq...>) -> decltype(std::forward_as_tuple(std::get<Seq>(args)...))
-        {
-            return std::forward_as_tuple(std::get<Seq>(args)...);
-        }
-
         template <typename T, typename... Args, int... Seq>
-        static void DoPlace(T* mem, std::tuple<const Args&...> args, Index<Seq...>)
+        static void DoPlace(T* mem, std::tuple<Args...>&& args, Index<Seq...>)
         {
-            new (mem)T(std::get<Seq>(args)...);
+            new (mem)T(std::forward<Args>(std::get<Seq>(args))...);
         }
 
     public:
-        template <typename... Args>
-        static std::tuple<const Args&...> ConstTie(std::tuple<Args...>& args)
-        {
-            return MakeTie(args, GenSequence<sizeof...(Args)>{});
-        }
-        template <typename... Args>
-        static std::tuple<Args&...> Tie(std::tuple<Args...>& args)
-        {
-            return MakeTie(args, GenSequence<sizeof...(Args)>{});
-        }
-
-        template <int Start, int Count, typename... Args>
-        static auto Split(std::tuple<Args&...> args) -> decltype(DoSplit(args, GenOffsetSequence<Start, Count>{}))
-        {
-            return DoSplit(args, GenOffsetSequence<Start, Count>{});
-        }
-
         template <typename T, typename... Args>
-        static void Place(T* mem, std::tuple<const Args&...> args)
+        static void Place(T* mem, std::tuple<Args...>&& args)
         {
-            DoPlace(mem, args, GenSequence<sizeof...(Args)>{});
+            DoPlace(mem, std::move(args), GenSequence<sizeof...(Args)>{});
         }
     };
 }
@@ -0,0 +1,53 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// LuaConnect/Helpers/TypeInfo.h
+///////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef LUACONNECT_HELPERS_TYPEINFO
+#define LUACONNECT_HELPERS_TYPEINFO
+
+#include "..\Config.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Preprocessor
+///////////////////////////////////////////////////////////////////////////////////////////////////
+#include <vector>
+
+namespace LuaConnect
+{
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Struct - TypeInfo
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    struct LUACONNECT_API TypeInfo
+    {
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Nested Types
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    public:
+        ///////////////////////////////////////////////////////////////////////////////////////////
+        /// Struct - Ancestor
+        ///////////////////////////////////////////////////////////////////////////////////////////
+        struct Ancestor
+        {
+            const TypeInfo* type;
+
+            // Converts a pointer to the ancestor at index via (or the type itself if negative) to this ancestor
+            void* (*cast)(void* object);
+            int via;
+        };
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    private:
+        void* CastAt(void* object, int index) const;
+
+    public:
+        // Every base, direct or indirect, flattened when the type is registered
+        std::vector<Ancestor> ancestors;
+
+        int Find(const TypeInfo* type) const;
+
+        void* Cast(void* object, const TypeInfo* type) const;
+    };
+}
+
+#endif LUACONNECT_HELPERS_TYPEINFO
@@ -0,0 +1,81 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// LuaConnect/Helpers/UserdataHeader.h
+///////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef LUACONNECT_HELPERS_USERDATAHEADER
+#define LUACONNECT_HELPERS_USERDATAHEADER
+
+#include "..\Config.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Preprocessor
+///////////////////////////////////////////////////////////////////////////////////////////////////
+#include "TypeInfo.h"
+
+#include <cstddef>
+#include <type_traits>
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Forward Declarations
+///////////////////////////////////////////////////////////////////////////////////////////////////
+struct lua_State;
+
+namespace LuaConnect
+{
+    template <typename T>
+    class Type;
+}
+
+namespace LuaConnect
+{
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Struct - UserdataHeader
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    struct LUACONNECT_API UserdataHeader
+    {
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Static Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    private:
+        // Marks userdata created by LuaConnect, as scripts can pass any other library's userdata
+        static const unsigned int Magic = 0x4C43554Eu;
+
+        template <typename T>
+        static constexpr std::size_t Offset();
+
+        template <typename Storage>
+        static void Release(UserdataHeader* header);
+
+    public:
+        template <typename T, typename Storage = T>
+        static Storage* Allocate(lua_State* state);
+        template <typename T>
+        static void AllocateRef(lua_State* state, T* object);
+
+        static UserdataHeader* Get(lua_State* state, int index);
+
+        template <typename T>
+        static T* Check(lua_State* state, int index);
+        static void* GetObject(lua_State* state, int index);
+        static void* GetObject(lua_State* state, int index, const TypeInfo* type);
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    public:
+        unsigned int magic;
+
+        // Type<T>::ClassKey() of the object, so checking an exact type is a single pointer compare
+        const TypeInfo* type;
+        void* object;
+
+        // Destroys whatever the userdata stores (the object itself or a holder owning it), null if nothing needs destroying
+        void (*release)(UserdataHeader* header);
+    };
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Inline Includes
+///////////////////////////////////////////////////////////////////////////////////////////////////
+#include "UserdataHeader.inl"
+
+#endif LUACONNECT_HELPERS_USERDATAHEADER
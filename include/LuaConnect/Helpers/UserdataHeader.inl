@@ -0,0 +1,72 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// LuaConnect/Helpers/UserdataHeader.inl
+///////////////////////////////////////////////////////////////////////////////////////////////////
+#include "UserdataHeader.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Preprocessor
+///////////////////////////////////////////////////////////////////////////////////////////////////
+#include "Headers.h"
+
+namespace LuaConnect
+{
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// UserdataHeader - Private Static Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    constexpr std::size_t UserdataHeader::Offset()
+    {
+        // The object follows the header, rounded up to its alignment
+        return (sizeof(UserdataHeader) + alignof(T) - 1) / alignof(T) * alignof(T);
+    }
+
+    template <typename Storage>
+    void UserdataHeader::Release(UserdataHeader* header)
+    {
+        reinterpret_cast<Storage*>(reinterpret_cast<char*>(header) + Offset<Storage>())->~Storage();
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// UserdataHeader - Public Static Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    template <typename T, typename Storage>
+    Storage* UserdataHeader::Allocate(lua_State* state)
+    {
+        // Create the userdata (on the stack), leaving the storage to be constructed by the caller
+        char* memory = static_cast<char*>(lua_newuserdata(state, Offset<Storage>() + sizeof(Storage)));
+
+        // The object is the storage itself, unless it's a holder which the caller points it through
+        UserdataHeader* header = reinterpret_cast<UserdataHeader*>(memory);
+        header->magic = Magic;
+        header->type = Type<T>::ClassKey();
+        header->object = memory + Offset<Storage>();
+        header->release = (std::is_trivially_destructible<Storage>::value ? nullptr : &Release<Storage>);
+
+        return static_cast<Storage*>(header->object);
+    }
+
+    template <typename T>
+    void UserdataHeader::AllocateRef(lua_State* state, T* object)
+    {
+        // References are just the header, pointing at an object owned by C++ with nothing to release
+        UserdataHeader* header = static_cast<UserdataHeader*>(lua_newuserdata(state, sizeof(UserdataHeader)));
+        header->magic = Magic;
+        header->type = Type<T>::ClassKey();
+        header->object = object;
+        header->release = nullptr;
+    }
+
+    template <typename T>
+    T* UserdataHeader::Check(lua_State* state, int index)
+    {
+        UserdataHeader* header = Get(state, index);
+        if (header == nullptr)
+            return nullptr;
+
+        if (header->type == Type<T>::ClassKey())
+            return static_cast<T*>(header->object);
+
+        // Otherwise T may be a base, found in the ancestry of the actual type
+        return static_cast<T*>(header->type->Cast(header->object, Type<T>::ClassKey()));
+    }
+}
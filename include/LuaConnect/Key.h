@@ -0,0 +1,59 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// LuaConnect/Key.h
+///////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef LUACONNECT_KEY
+#define LUACONNECT_KEY
+
+#include "Config.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Preprocessor
+///////////////////////////////////////////////////////////////////////////////////////////////////
+#include "Helpers\StateView.h"
+
+#include <string_view>
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Forward Declarations
+///////////////////////////////////////////////////////////////////////////////////////////////////
+namespace LuaConnect
+{
+    class VM;
+}
+
+namespace LuaConnect
+{
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Class - Key
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    class LUACONNECT_API Key
+    {
+        template <typename T>
+        friend class Stack;
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Static Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    private:
+        static unsigned char s_cache;
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    private:
+        // The main thread of the VM which created the key, its registry is the only one holding the string
+        StateView m_state;
+
+        // Shared by every key for the same string, interned strings live as long as the VM which created them
+        int m_ref;
+
+    public:
+        Key();
+        Key(VM& vm, std::string_view name);
+
+        bool operator==(const Key& rhs) const;
+        bool operator!=(const Key& rhs) const;
+    };
+}
+
+#endif LUACONNECT_KEY
@@ -0,0 +1,50 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// LuaConnect/Struct.h
+///////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef LUACONNECT_STRUCT
+#define LUACONNECT_STRUCT
+
+#include "Config.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Preprocessor
+///////////////////////////////////////////////////////////////////////////////////////////////////
+#include <tuple>
+#include <type_traits>
+
+// Describes a field of a struct, using the member name as the table key
+#define LUACONNECT_FIELD(Type, Member) LuaConnect::Field<Type, decltype(Type::Member)>{ #Member, &Type::Member }
+
+namespace LuaConnect
+{
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Struct - Field
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    template <typename T, typename M>
+    struct Field
+    {
+        using Type = M;
+
+        const char* name;
+        M T::* member;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Struct - StructFields
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    // Specialize with a static constexpr tuple of Field named fields, for the struct to be converted to and from tables:
+    //     template <> struct StructFields<Order> { static constexpr auto fields = std::make_tuple(LUACONNECT_FIELD(Order, id)); };
+    template <typename T>
+    struct StructFields;
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Struct - IsStruct
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    template <typename T, typename = void>
+    struct IsStruct : std::false_type { };
+
+    template <typename T>
+    struct IsStruct<T, std::void_t<decltype(StructFields<T>::fields)>> : std::true_type { };
+}
+
+#endif LUACONNECT_STRUCT
@@ -11,14 +11,13 @@
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 #include "Helpers\Ref.h"
 
-#include <memory>
+#include <vector>
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 /// Forward Declarations
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 namespace LuaConnect
 {
-    class State;
     class VM;
 }
 
@@ -34,32 +33,31 @@ namespace LuaConnect
         template <typename T>
         friend class Userdata;
 
+        friend class TableArg;
+
     ///////////////////////////////////////////////////////////////////////////////////////////////
-    /// Nested Types
+    /// Static Members
     ///////////////////////////////////////////////////////////////////////////////////////////////
     private:
-        ///////////////////////////////////////////////////////////////////////////////////////////
-        /// Struct - CallHandler
-        ///////////////////////////////////////////////////////////////////////////////////////////
+        template <typename K>
+        static bool ExistsAt(StateView state, int index, const K& key);
+        template <typename V, typename K>
+        static V GetAt(StateView state, int index, const K& key);
+        template <typename V, typename K>
+        static void SetAt(StateView state, int index, const K& key, const V& value);
+
         template <typename R, typename K, typename... Args>
-        struct CallHandler
-        {
-            static R Call(Table& table, K key, const Args&... args);
-        };
-        template <typename K, typename... Args>
-        struct CallHandler<void, K, Args...>
-        {
-            static void Call(Table& table, K key, const Args&... args);
-        };
+        static R CallAt(StateView state, int index, const K& key, const Args&... args);
 
     ///////////////////////////////////////////////////////////////////////////////////////////////
     /// Members
     ///////////////////////////////////////////////////////////////////////////////////////////////
     private:
-        Table(std::shared_ptr<State> state);
+        Table(StateView state);
 
     public:
         Table();
+        Table(const Table& other);
         Table(Table&& other);
         Table(VM& vm);
 
@@ -77,6 +75,8 @@ namespace LuaConnect
 
         template <typename R, typename K, typename... Args>
         R Call(const K& key, const Args&... args);
+        template <typename R, typename K, typename... Args>
+        std::vector<R> CallAll(const K& key, const Args&... args);
     };
 }
 
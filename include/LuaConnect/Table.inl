@@ -15,19 +15,65 @@
 namespace LuaConnect
 {
     ///////////////////////////////////////////////////////////////////////////////////////////////
-    /// Table::CallHandler - Public Members
+    /// Table - Private Static Members
     ///////////////////////////////////////////////////////////////////////////////////////////////
-    template <typename R, typename K, typename... Args>
-    R Table::CallHandler<R, K, Args...>::Call(Table& table, K key, const Args&... args)
+    template <typename K>
+    bool Table::ExistsAt(StateView state, int index, const K& key)
     {
-        Function f = table.Get<Function>(key);
-        return f.Call<R>(args...);
+        Balance b(state, 0);
+
+        Stack<K>::Push(state, key);
+        lua_gettable(state.state, index);
+
+        bool exists = !lua_isnil(state.state, -1);
+        lua_pop(state.state, 1);
+
+        return exists;
     }
-    template <typename K, typename... Args>
-    void Table::CallHandler<void, K, Args...>::Call(Table& table, K key, const Args&... args)
+    template <typename V, typename K>
+    V Table::GetAt(StateView state, int index, const K& key)
     {
-        Function f = table.Get<Function>(key);
-        f.Call<void>(args...);
+        static_assert(StackOwned<V>::value);
+
+        Balance b(state, 0);
+
+        Stack<K>::Push(state, key);
+        lua_gettable(state.state, index);
+
+        try
+        {
+            V result = Stack<V>::Get(state, -1);
+            lua_pop(state.state, 1);
+
+            return result;
+        }
+        catch (LuaException&)
+        {
+            lua_pop(state.state, 1);
+            throw;
+        }
+    }
+    template <typename V, typename K>
+    void Table::SetAt(StateView state, int index, const K& key, const V& value)
+    {
+        Balance b(state, 0);
+
+        Stack<K>::Push(state, key);
+        Stack<V>::Push(state, value);
+
+        lua_settable(state.state, index);
+    }
+
+    template <typename R, typename K, typename... Args>
+    R Table::CallAt(StateView state, int index, const K& key, const Args&... args)
+    {
+        Balance b(state, 0);
+
+        Stack<K>::Push(state, key);
+        lua_gettable(state.state, index);
+
+        // Call the function straight from the table, without taking a reference to it
+        return Function::CallHandler<R, Args...>::Call(state, args...);
     }
 
     ///////////////////////////////////////////////////////////////////////////////////////////////
@@ -39,12 +85,9 @@ namespace LuaConnect
         Balance b(m_state, 0);
 
         Ref::Push();
-        Stack<K>::Push(m_state, key);
 
-        lua_gettable(m_state->state, -2);
-
-        bool exists = !lua_isnil(m_state->state, -1);
-        lua_pop(m_state->state, 2);
+        bool exists = ExistsAt(m_state, lua_gettop(m_state.state), key);
+        lua_pop(m_state.state, 1);
 
         return exists;
     }
@@ -54,20 +97,17 @@ namespace LuaConnect
         Balance b(m_state, 0);
 
         Ref::Push();
-        Stack<K>::Push(m_state, key);
-
-        lua_gettable(m_state->state, -2);
 
         try
         {
-            V result = Stack<V>::Get(m_state, -1);
-            lua_pop(m_state->state, 2);
+            V result = GetAt<V>(m_state, lua_gettop(m_state.state), key);
+            lua_pop(m_state.state, 1);
 
             return result;
         }
         catch (LuaException&)
         {
-            lua_pop(m_state->state, 2);
+            lua_pop(m_state.state, 1);
             throw;
         }
     }
@@ -77,11 +117,9 @@ namespace LuaConnect
         Balance b(m_state, 0);
 
         Ref::Push();
-        Stack<K>::Push(m_state, key);
-        Stack<V>::Push(m_state, value);
 
-        lua_settable(m_state->state, -3);
-        lua_pop(m_state->state, 1);
+        SetAt(m_state, lua_gettop(m_state.state), key, value);
+        lua_pop(m_state.state, 1);
     }
 
     template <typename R, typename K, typename... Args>
@@ -89,6 +127,27 @@ namespace LuaConnect
     {
         Balance b(m_state, 0);
 
-        return Table::CallHandler<R, K, Args...>::Call(*this, key, args...);
+        Ref::Push();
+        Stack<K>::Push(m_state, key);
+
+        lua_gettable(m_state.state, -2);
+
+        // Only the function is needed for the call, without taking a reference to it
+        lua_remove(m_state.state, -2);
+
+        return Function::CallHandler<R, Args...>::Call(m_state, args...);
+    }
+    template <typename R, typename K, typename... Args>
+    std::vector<R> Table::CallAll(const K& key, const Args&... args)
+    {
+        Balance b(m_state, 0);
+
+        Ref::Push();
+        Stack<K>::Push(m_state, key);
+
+        lua_gettable(m_state.state, -2);
+        lua_remove(m_state.state, -2);
+
+        return Function::PerformCallAll<R>(m_state, args...);
     }
 }
\ No newline at end of file
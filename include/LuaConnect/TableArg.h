@@ -0,0 +1,58 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// LuaConnect/TableArg.h
+///////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef LUACONNECT_TABLEARG
+#define LUACONNECT_TABLEARG
+
+#include "Config.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Preprocessor
+///////////////////////////////////////////////////////////////////////////////////////////////////
+#include "Helpers\Slot.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Forward Declarations
+///////////////////////////////////////////////////////////////////////////////////////////////////
+namespace LuaConnect
+{
+    class Table;
+}
+
+namespace LuaConnect
+{
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Class - TableArg
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    class LUACONNECT_API TableArg : private Slot
+    {
+        template <typename T>
+        friend class Stack;
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    private:
+        TableArg(StateView state, int index);
+
+    public:
+        template <typename K>
+        bool Exists(const K& key);
+        template <typename V, typename K>
+        V Get(const K& key);
+        template <typename V, typename K>
+        void Set(const K& key, const V& value);
+
+        template <typename R, typename K, typename... Args>
+        R Call(const K& key, const Args&... args);
+
+        Table Promote() const;
+    };
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Inline Includes
+///////////////////////////////////////////////////////////////////////////////////////////////////
+#include "TableArg.inl"
+
+#endif LUACONNECT_TABLEARG
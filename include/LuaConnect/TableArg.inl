@@ -0,0 +1,37 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// LuaConnect/TableArg.inl
+///////////////////////////////////////////////////////////////////////////////////////////////////
+#include "TableArg.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Preprocessor
+///////////////////////////////////////////////////////////////////////////////////////////////////
+#include "Table.h"
+
+namespace LuaConnect
+{
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// TableArg - Public Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    template <typename K>
+    bool TableArg::Exists(const K& key)
+    {
+        return Table::ExistsAt(m_state, m_index, key);
+    }
+    template <typename V, typename K>
+    V TableArg::Get(const K& key)
+    {
+        return Table::GetAt<V>(m_state, m_index, key);
+    }
+    template <typename V, typename K>
+    void TableArg::Set(const K& key, const V& value)
+    {
+        Table::SetAt(m_state, m_index, key, value);
+    }
+
+    template <typename R, typename K, typename... Args>
+    R TableArg::Call(const K& key, const Args&... args)
+    {
+        return Table::CallAt<R>(m_state, m_index, key, args...);
+    }
+}
@@ -10,9 +10,14 @@
 /// Preprocessor
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 #include "Table.h"
+#include "Helpers\Operators.h"
+#include "Helpers\Templates.h"
+#include "Helpers\TypeInfo.h"
 
 #include <string>
 #include <tuple>
+#include <type_traits>
+#include <utility>
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 /// Forward Declarations
@@ -26,6 +31,39 @@ namespace LuaConnect
 
 namespace LuaConnect
 {
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Class - GenericMeta
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    class LUACONNECT_API GenericMeta
+    {
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Nested Types
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    public:
+        ///////////////////////////////////////////////////////////////////////////////////////////
+        /// Struct - Property
+        ///////////////////////////////////////////////////////////////////////////////////////////
+        struct Property
+        {
+            // The type declaring the member, which the object is cast to before access
+            const TypeInfo* type;
+
+            // Pushes the value of the property
+            void (*get)(lua_State* state, void* object, const Property* property);
+            // Assigns the value at index to the property, null if read only
+            void (*set)(lua_State* state, void* object, const Property* property, int index);
+        };
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    public:
+        static int Index(lua_State* state);
+        static int NewIndex(lua_State* state);
+
+        static int ToString(lua_State* state);
+    };
+
     ///////////////////////////////////////////////////////////////////////////////////////////////
     /// Class - Type
     ///////////////////////////////////////////////////////////////////////////////////////////////
@@ -45,50 +83,102 @@ namespace LuaConnect
         template <typename... Args>
         struct ConstructHandler
         {
+        private:
+            template <int... Seq>
+            static int Construct(lua_State* state, Index<Seq...>);
+
+        public:
+            static int Call(lua_State* state);
+        };
+
+        ///////////////////////////////////////////////////////////////////////////////////////////
+        /// Struct - OperatorHandler
+        ///////////////////////////////////////////////////////////////////////////////////////////
+        template <typename Op>
+        struct OperatorHandler
+        {
+            using R = std::decay_t<decltype(Op::Apply(std::declval<const T&>(), std::declval<const T&>()))>;
+
             static int Call(lua_State* state);
         };
 
+        ///////////////////////////////////////////////////////////////////////////////////////////
+        /// Struct - MemberProperty
+        ///////////////////////////////////////////////////////////////////////////////////////////
+        template <typename M>
+        struct MemberProperty : GenericMeta::Property
+        {
+            M T::* member;
+
+            MemberProperty(M T::* member, bool readOnly);
+
+            static void Get(lua_State* state, void* object, const GenericMeta::Property* property);
+            static void Set(lua_State* state, void* object, const GenericMeta::Property* property, int index);
+        };
+
+        ///////////////////////////////////////////////////////////////////////////////////////////
+        /// Struct - BoundProperty
+        ///////////////////////////////////////////////////////////////////////////////////////////
+        template <auto Member, bool ReadOnly>
+        struct BoundProperty
+        {
+            using M = std::remove_reference_t<decltype(std::declval<T&>().*Member)>;
+
+            static const GenericMeta::Property s_property;
+
+            static void Get(lua_State* state, void* object, const GenericMeta::Property* property);
+            static void Set(lua_State* state, void* object, const GenericMeta::Property* property, int index);
+        };
+
     ///////////////////////////////////////////////////////////////////////////////////////////////
     /// Static Members
     ///////////////////////////////////////////////////////////////////////////////////////////////
     private:
-        static unsigned char s_key;
+        static TypeInfo s_info;
 
         static Table CreateMetatable(VM& vm, std::string name);
 
         static int Deconstruct(lua_State* state);
 
+        template <typename Op>
+        static void AddOperator(Table& meta);
+        static void AddOperators(VM& vm, Table& meta);
+        static int Length(lua_State* state);
+
+        static Table GetProperties(VM& vm);
+
+        template <typename Base>
+        static void* Upcast(void* object);
+        template <typename Base>
+        static void Inherit(VM& vm, Table& meta);
+
     public:
-        static const void* ClassKey() { return &s_key; }
+        static const TypeInfo* ClassKey() { return &s_info; }
 
-        static Table GetMetatable(std::shared_ptr<State> state);
+        static Table GetMetatable(StateView state);
 
         static bool Exists(VM& vm);
+        template <typename... Bases>
         static void RegisterType(VM& vm, std::string name);
 
         template <typename... Args>
         static void AddConstructor(VM& vm, Table& typeTable);
-        static void AddDeconstructor(VM& vm);
 
         template <typename F, typename... Upvalues>
         static void AddFunction(VM& vm, std::string name, F func, const Upvalues&... args);
-    };
-
-    ///////////////////////////////////////////////////////////////////////////////////////////////
-    /// Class - GenericMeta
-    ///////////////////////////////////////////////////////////////////////////////////////////////
-    class LUACONNECT_API GenericMeta
-    {
-    ///////////////////////////////////////////////////////////////////////////////////////////////
-    /// Members
-    ///////////////////////////////////////////////////////////////////////////////////////////////
-    public:
-        static int DummyDeconstruct(lua_State* state);
-
-        static int Index(lua_State* state);
-        static int NewIndex(lua_State* state);
-
-        static int ToString(lua_State* state);
+        template <auto F, typename... Upvalues>
+        static void AddFunction(VM& vm, std::string name, const Upvalues&... args);
+        template <typename... Fs>
+        static void AddOverloaded(VM& vm, std::string name, Fs... funcs);
+
+        template <typename M>
+        static void AddProperty(VM& vm, std::string name, M T::* member);
+        template <auto Member>
+        static void AddProperty(VM& vm, std::string name);
+        template <typename M>
+        static void AddReadOnlyProperty(VM& vm, std::string name, M T::* member);
+        template <auto Member>
+        static void AddReadOnlyProperty(VM& vm, std::string name);
     };
 }
 
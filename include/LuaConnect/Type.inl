@@ -9,6 +9,7 @@
 #include "Helpers\Balance.h"
 #include "Helpers\Headers.h"
 #include "Helpers\Stack.h"
+#include "Helpers\UserdataHeader.h"
 #include "VM.h"
 
 #include <assert.h>
@@ -22,41 +23,72 @@ namespace LuaConnect
     ///////////////////////////////////////////////////////////////////////////////////////////////
     template <typename T>
     template <typename... Args>
-    int Type<T>::ConstructHandler<Args...>::Call(lua_State* state)
+    template <int... Seq>
+    int Type<T>::ConstructHandler<Args...>::Construct(lua_State* state, Index<Seq...>)
     {
         // Check we got the correct number of arguments
         int reqArgs = std::tuple_size<std::tuple<Args...>>::value;
         if (lua_gettop(state) != reqArgs)
             return luaL_error(state, "Not enough arguments, expected %d got %d.", reqArgs, lua_gettop(state));
 
-        // Create the State needed for calls to C++ code
-        std::shared_ptr<State> luaState(new State(state));
+        // Borrow the State needed for calls to C++ code
+        StateView luaState(state);
 
         Balance b(luaState, 1);
 
-        // Grab all the arguments off the stack
-        std::tuple<Args...> args;
+        // Create the userdata, forwarding each argument straight from the stack into the constructor
         try
         {
-            StackHelper::GetStack(luaState, Template::Tie(args));
+            Userdata<T>::PushNew(luaState, Stack<std::decay_t<Args>>::Get(luaState, Seq + 1)...);
         }
         catch (LuaException& e)
         {
             return luaL_error(state, "%s", e.what());
         }
 
-        // Create the userdata
+        return 1;
+    }
+
+    template <typename T>
+    template <typename... Args>
+    int Type<T>::ConstructHandler<Args...>::Call(lua_State* state)
+    {
+        return Construct(state, GenSequence<sizeof...(Args)>{});
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Type::OperatorHandler - Public Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    template <typename Op>
+    int Type<T>::OperatorHandler<Op>::Call(lua_State* state)
+    {
+        // Both operands must be the type, Lua may pass them in either order
+        const T* a = UserdataHeader::Check<T>(state, 1);
+        const T* b = UserdataHeader::Check<T>(state, 2);
+        if (a == nullptr || b == nullptr)
+            return luaL_error(state, "Both operands of %s must be the same userdata type.", Op::Name);
+
+        // Borrow the State needed for calls to C++ code
+        StateView luaState(state);
+
         try
         {
-            Userdata<T> userdata(luaState, Template::ConstTie(args));
-
-            // Push it onto the stack
-            Stack<Userdata<T>>::Push(luaState, userdata);
+            // Results of the type itself are moved into new userdata, anything else is pushed as a value
+            Stack<R>::Push(luaState, Op::Apply(*a, *b));
         }
-        catch (LuaException& e)
+        catch (const LuaException& e)
         {
             return luaL_error(state, "%s", e.what());
         }
+        catch (const std::exception& e)
+        {
+            return luaL_error(state, "Exception during execution: %s", e.what());
+        }
+        catch (...)
+        {
+            return luaL_error(state, "Unknown exception during execution.");
+        }
 
         return 1;
     }
@@ -65,61 +97,275 @@ namespace LuaConnect
     /// Type - Private Static Members
     ///////////////////////////////////////////////////////////////////////////////////////////////
     template <typename T>
-    unsigned char Type<T>::s_key = 0;
+    TypeInfo Type<T>::s_info;
 
     template <typename T>
     Table Type<T>::CreateMetatable(VM& vm, std::string name)
     {
         Balance b(vm.m_state, 0);
 
-        // Create the metatable, registering the deconstructor, index and new index metamethods
+        // Create the metatable, registering the deconstructor only if there is something to destroy,
+        // as Lua keeps objects with a __gc metamethod alive for an extra collection cycle
         Table meta(vm);
-        meta.Set("__gc", &GenericMeta::DummyDeconstruct);
-        meta.Set("__index", &GenericMeta::Index);
-        meta.Set("__newindex", &GenericMeta::NewIndex);
+        if constexpr (!std::is_trivially_destructible<T>::value)
+            meta.Set("__gc", &Type<T>::Deconstruct);
+
+        // Create an empty table for functions, used directly as __index so a method lookup is a single raw get
+        Table functions(vm);
+        meta.Set("__functions", functions);
+        meta.Set("__index", functions);
 
-        // Create an empty table for functions in the metatable
-        meta.Set("__functions", Table(vm));
+        // Create an empty table for properties, which __newindex resolves assignments through
+        Table properties(vm);
+        meta.Set("__properties", properties);
+
+        Stack<Table>::Push(vm.m_state, meta);
+        Stack<Table>::Push(vm.m_state, properties);
+        lua_pushcclosure(vm.m_state.state, &GenericMeta::NewIndex, 1);
+        lua_setfield(vm.m_state.state, -2, "__newindex");
+        lua_pop(vm.m_state.state, 1);
 
         // Add the __tostring metamethod
         meta.Set("__name", name);
         meta.Set("__tostring", &GenericMeta::ToString);
 
+        // Add metamethods for any operators the type provides
+        AddOperators(vm, meta);
+
         return meta;
     }
 
     template <typename T>
     int Type<T>::Deconstruct(lua_State* state)
     {
-        // Create the State needed for calls to C++ code
-        std::shared_ptr<State> luaState(new State(state));
+        // The metatable is reachable from scripts, so __gc may be called by hand with anything
+        UserdataHeader* header = UserdataHeader::Get(state, 1);
+        if (header == nullptr)
+            return luaL_error(state, "Argument 1 is not the expected userdata type.");
 
-        Balance b(luaState, 1);
+        // References and objects already released have nothing left to do
+        if (header->release == nullptr)
+            return 0;
+
+        // Copies may carry the metatable of one of their bases, release stays that of the stored type
+        if (header->type != Type<T>::ClassKey() && header->type->Find(Type<T>::ClassKey()) < 0)
+            return luaL_error(state, "Argument 1 is not the expected userdata type.");
 
-        // Grab the userdata from the stack
-        Userdata<T> userdata(luaState);;
+        // Release whatever the userdata stores, be it the object or a holder sharing it, at most once
+        void (*release)(UserdataHeader*) = header->release;
+        header->release = nullptr;
 
-        // Deconstruct it
-        userdata.GetPointer()->~T();
+        release(header);
 
         return 0;
     }
 
+    template <typename T>
+    template <typename Op>
+    void Type<T>::AddOperator(Table& meta)
+    {
+        if constexpr (HasOperator<Op, T>::value)
+        {
+            using R = typename OperatorHandler<Op>::R;
+
+            // Only register operators whose result can be pushed
+            if constexpr (std::is_same<R, T>::value || StackType<R>::value != LUA_TNONE)
+                meta.Set(Op::Name, &OperatorHandler<Op>::Call);
+        }
+    }
+    template <typename T>
+    void Type<T>::AddOperators(VM& vm, Table& meta)
+    {
+        AddOperator<Operator::Add>(meta);
+        AddOperator<Operator::Sub>(meta);
+        AddOperator<Operator::Mul>(meta);
+        AddOperator<Operator::Div>(meta);
+        AddOperator<Operator::Eq>(meta);
+        AddOperator<Operator::Lt>(meta);
+        AddOperator<Operator::Le>(meta);
+
+        // Calling the object goes straight to the member callback, with the object as self
+        if constexpr (HasCall<T>::value)
+            meta.Set("__call", Function::CreateFunction<&T::operator()>(vm));
+
+        if constexpr (HasSize<T>::value)
+            meta.Set("__len", &Type<T>::Length);
+    }
+    template <typename T>
+    int Type<T>::Length(lua_State* state)
+    {
+        const T* object = UserdataHeader::Check<T>(state, 1);
+        if (object == nullptr)
+            return luaL_error(state, "Argument 1 is not the expected userdata type.");
+
+        lua_pushinteger(state, static_cast<lua_Integer>(object->size()));
+        return 1;
+    }
+
+    template <typename T>
+    Table Type<T>::GetProperties(VM& vm)
+    {
+        Balance b(vm.m_state, 0);
+
+        // Get the metatable from the registry
+        Table meta = GetMetatable(vm.m_state);
+        Table properties = meta.Get<Table>(std::string("__properties"));
+
+        // While __index is still the functions table, replace it with a metamethod that falls back to properties
+        Stack<Table>::Push(vm.m_state, meta);
+        lua_getfield(vm.m_state.state, -1, "__index");
+        if (lua_istable(vm.m_state.state, -1))
+        {
+            Stack<Table>::Push(vm.m_state, properties);
+            lua_pushcclosure(vm.m_state.state, &GenericMeta::Index, 2);
+            lua_setfield(vm.m_state.state, -2, "__index");
+        }
+        else
+        {
+            lua_pop(vm.m_state.state, 1);
+        }
+        lua_pop(vm.m_state.state, 1);
+
+        return properties;
+    }
+
+    template <typename T>
+    template <typename Base>
+    void* Type<T>::Upcast(void* object)
+    {
+        return static_cast<Base*>(static_cast<T*>(object));
+    }
+    template <typename T>
+    template <typename Base>
+    void Type<T>::Inherit(VM& vm, Table& meta)
+    {
+        static_assert(std::is_base_of<Base, T>::value, "Type must derive from each of its bases.");
+
+        Balance b(vm.m_state, 0);
+
+        // Record the base and its own ancestry, so checks never need to walk the hierarchy
+        const TypeInfo* base = Type<Base>::ClassKey();
+        if (s_info.Find(base) < 0)
+        {
+            int via = static_cast<int>(s_info.ancestors.size());
+            s_info.ancestors.push_back({ base, &Type<T>::Upcast<Base>, -1 });
+
+            for (const TypeInfo::Ancestor& ancestor : base->ancestors)
+                s_info.ancestors.push_back({ ancestor.type, ancestor.cast, (ancestor.via < 0 ? via : ancestor.via + via + 1) });
+        }
+
+        // Copy the methods and properties down, leaving any already inherited from an earlier base
+        Table baseMeta = Type<Base>::GetMetatable(vm.m_state);
+
+        for (const char* name : { "__functions", "__properties" })
+        {
+            Stack<Table>::Push(vm.m_state, meta);
+            lua_getfield(vm.m_state.state, -1, name);
+            Stack<Table>::Push(vm.m_state, baseMeta);
+            lua_getfield(vm.m_state.state, -1, name);
+
+            lua_pushnil(vm.m_state.state);
+            while (lua_next(vm.m_state.state, -2) != 0)
+            {
+                lua_pushvalue(vm.m_state.state, -2);
+                lua_rawget(vm.m_state.state, -6);
+                if (lua_isnil(vm.m_state.state, -1))
+                {
+                    lua_pop(vm.m_state.state, 1);
+                    lua_pushvalue(vm.m_state.state, -2);
+                    lua_insert(vm.m_state.state, -2);
+                    lua_rawset(vm.m_state.state, -6);
+                }
+                else
+                {
+                    lua_pop(vm.m_state.state, 2);
+                }
+            }
+
+            lua_pop(vm.m_state.state, 4);
+        }
+
+        // Inherited properties need the __index metamethod in place of the plain functions table
+        Stack<Table>::Push(vm.m_state, baseMeta);
+        lua_getfield(vm.m_state.state, -1, "__index");
+        bool hasProperties = !lua_istable(vm.m_state.state, -1);
+        lua_pop(vm.m_state.state, 2);
+
+        if (hasProperties)
+            GetProperties(vm);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Type::MemberProperty - Public Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    template <typename M>
+    Type<T>::MemberProperty<M>::MemberProperty(M T::* member, bool readOnly) : member(member)
+    {
+        type = Type<T>::ClassKey();
+        get = &MemberProperty<M>::Get;
+        set = (readOnly || std::is_const<M>::value ? nullptr : &MemberProperty<M>::Set);
+    }
+
+    template <typename T>
+    template <typename M>
+    void Type<T>::MemberProperty<M>::Get(lua_State* state, void* object, const GenericMeta::Property* property)
+    {
+        M T::* member = static_cast<const MemberProperty<M>*>(property)->member;
+        Stack<std::remove_cv_t<M>>::Push(state, static_cast<T*>(object)->*member);
+    }
+    template <typename T>
+    template <typename M>
+    void Type<T>::MemberProperty<M>::Set(lua_State* state, void* object, const GenericMeta::Property* property, int index)
+    {
+        if constexpr (!std::is_const<M>::value)
+        {
+            M T::* member = static_cast<const MemberProperty<M>*>(property)->member;
+            static_cast<T*>(object)->*member = Stack<M>::Get(state, index);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Type::BoundProperty - Public Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    template <auto Member, bool ReadOnly>
+    const GenericMeta::Property Type<T>::BoundProperty<Member, ReadOnly>::s_property =
+    {
+        Type<T>::ClassKey(),
+        &Type<T>::BoundProperty<Member, ReadOnly>::Get,
+        (ReadOnly || std::is_const<M>::value ? nullptr : &Type<T>::BoundProperty<Member, ReadOnly>::Set)
+    };
+
+    template <typename T>
+    template <auto Member, bool ReadOnly>
+    void Type<T>::BoundProperty<Member, ReadOnly>::Get(lua_State* state, void* object, const GenericMeta::Property* property)
+    {
+        Stack<std::remove_cv_t<M>>::Push(state, static_cast<T*>(object)->*Member);
+    }
+    template <typename T>
+    template <auto Member, bool ReadOnly>
+    void Type<T>::BoundProperty<Member, ReadOnly>::Set(lua_State* state, void* object, const GenericMeta::Property* property, int index)
+    {
+        if constexpr (!std::is_const<M>::value)
+            static_cast<T*>(object)->*Member = Stack<M>::Get(state, index);
+    }
+
     ///////////////////////////////////////////////////////////////////////////////////////////////
     /// Type - Public Static Members
     ///////////////////////////////////////////////////////////////////////////////////////////////
     template <typename T>
-    Table Type<T>::GetMetatable(std::shared_ptr<State> state)
+    Table Type<T>::GetMetatable(StateView state)
     {
         Balance b(state, 0);
 
         // Push the metatable from the registry
-        lua_rawgetp(state->state, LUA_REGISTRYINDEX, Type<T>::ClassKey());
+        lua_rawgetp(state.state, LUA_REGISTRYINDEX, Type<T>::ClassKey());
 
         // Check it exists
-        if (lua_isnil(state->state, -1))
+        if (lua_isnil(state.state, -1))
         {
-            lua_pop(state->state, 1);
+            lua_pop(state.state, 1);
             throw LuaException("Type has not been registered with Lua.");
         }
 
@@ -132,6 +378,7 @@ namespace LuaConnect
         return !vm.GetMetatableName(Type<T>::ClassKey()).empty();
     }
     template <typename T>
+    template <typename... Bases>
     void Type<T>::RegisterType(VM& vm, std::string name)
     {
         assert(!name.empty());
@@ -139,21 +386,24 @@ namespace LuaConnect
         Balance b(vm.m_state, 0);
 
         // Check if the metatable already exists
-        lua_rawgetp(vm.m_state->state, LUA_REGISTRYINDEX, Type<T>::ClassKey());
-        if (lua_istable(vm.m_state->state, -1))
+        lua_rawgetp(vm.m_state.state, LUA_REGISTRYINDEX, Type<T>::ClassKey());
+        if (lua_istable(vm.m_state.state, -1))
         {
-            lua_pop(vm.m_state->state, 1);
+            lua_pop(vm.m_state.state, 1);
             return;
         }
 
         // Pop the value returned from the registry
-        lua_pop(vm.m_state->state, 1);
+        lua_pop(vm.m_state.state, 1);
 
         // Store the type name
         Table meta = CreateMetatable(vm, name);
 
         Stack<Table>::Push(vm.m_state, meta);
-        lua_rawsetp(vm.m_state->state, LUA_REGISTRYINDEX, Type<T>::ClassKey());
+        lua_rawsetp(vm.m_state.state, LUA_REGISTRYINDEX, Type<T>::ClassKey());
+
+        // Inherit from each base in order, the first base taking priority where names clash
+        (Inherit<Bases>(vm, meta), ...);
     }
 
     template <typename T>
@@ -169,20 +419,23 @@ namespace LuaConnect
         typeTable.Set(meta.Get<std::string>("__name"), &Type<T>::ConstructHandler<Args...>::Call);
     }
     template <typename T>
-    void Type<T>::AddDeconstructor(VM& vm)
+    template <typename F, typename... Upvalues>
+    void Type<T>::AddFunction(VM& vm, std::string name, F func, const Upvalues&... upvalues)
     {
         Balance b(vm.m_state, 0);
-            
+
         // Get the metatable from the registry
-        lua_rawgetp(vm.m_state->state, LUA_REGISTRYINDEX, Type<T>::ClassKey());
-        Table meta = Stack<Table>::Pop(vm.m_state);
+        Table meta = GetMetatable(vm.m_state);
 
-        meta.Set("__gc", &Type<T>::Deconstruct);
-    }
+        // Get the functions table from the metatable
+        Table functions = meta.Get<Table>(std::string("__functions"));
 
+        // Set the function in the functions table
+        functions.Set(name, Function::CreateFunction(vm, func, upvalues...));
+    }
     template <typename T>
-    template <typename F, typename... Upvalues>
-    void Type<T>::AddFunction(VM& vm, std::string name, F func, const Upvalues&... upvalues)
+    template <auto F, typename... Upvalues>
+    void Type<T>::AddFunction(VM& vm, std::string name, const Upvalues&... upvalues)
     {
         Balance b(vm.m_state, 0);
 
@@ -193,6 +446,80 @@ namespace LuaConnect
         Table functions = meta.Get<Table>(std::string("__functions"));
 
         // Set the function in the functions table
-        functions.Set(name, Function::CreateFunction(vm, func, upvalues...));
+        functions.Set(name, Function::CreateFunction<F>(vm, upvalues...));
+    }
+    template <typename T>
+    template <typename... Fs>
+    void Type<T>::AddOverloaded(VM& vm, std::string name, Fs... funcs)
+    {
+        Balance b(vm.m_state, 0);
+
+        // Get the metatable from the registry
+        Table meta = GetMetatable(vm.m_state);
+
+        // Get the functions table from the metatable
+        Table functions = meta.Get<Table>(std::string("__functions"));
+
+        // Set the overload set in the functions table
+        functions.Set(name, Function::CreateOverloaded(vm, funcs...));
+    }
+
+    template <typename T>
+    template <typename M>
+    void Type<T>::AddProperty(VM& vm, std::string name, M T::* member)
+    {
+        Balance b(vm.m_state, 0);
+
+        Table properties = GetProperties(vm);
+
+        // Store the member pointer in a userdata owned by the properties table
+        Stack<Table>::Push(vm.m_state, properties);
+        void* memory = lua_newuserdata(vm.m_state.state, sizeof(MemberProperty<M>));
+        new (memory) MemberProperty<M>(member, false);
+        lua_setfield(vm.m_state.state, -2, name.c_str());
+        lua_pop(vm.m_state.state, 1);
+    }
+    template <typename T>
+    template <auto Member>
+    void Type<T>::AddProperty(VM& vm, std::string name)
+    {
+        Balance b(vm.m_state, 0);
+
+        Table properties = GetProperties(vm);
+
+        // The member is known at compile time, so the accessors are static
+        Stack<Table>::Push(vm.m_state, properties);
+        lua_pushlightuserdata(vm.m_state.state, const_cast<GenericMeta::Property*>(&BoundProperty<Member, false>::s_property));
+        lua_setfield(vm.m_state.state, -2, name.c_str());
+        lua_pop(vm.m_state.state, 1);
+    }
+    template <typename T>
+    template <typename M>
+    void Type<T>::AddReadOnlyProperty(VM& vm, std::string name, M T::* member)
+    {
+        Balance b(vm.m_state, 0);
+
+        Table properties = GetProperties(vm);
+
+        // Store the member pointer in a userdata owned by the properties table
+        Stack<Table>::Push(vm.m_state, properties);
+        void* memory = lua_newuserdata(vm.m_state.state, sizeof(MemberProperty<M>));
+        new (memory) MemberProperty<M>(member, true);
+        lua_setfield(vm.m_state.state, -2, name.c_str());
+        lua_pop(vm.m_state.state, 1);
+    }
+    template <typename T>
+    template <auto Member>
+    void Type<T>::AddReadOnlyProperty(VM& vm, std::string name)
+    {
+        Balance b(vm.m_state, 0);
+
+        Table properties = GetProperties(vm);
+
+        // The member is known at compile time, so the accessors are static
+        Stack<Table>::Push(vm.m_state, properties);
+        lua_pushlightuserdata(vm.m_state.state, const_cast<GenericMeta::Property*>(&BoundProperty<Member, true>::s_property));
+        lua_setfield(vm.m_state.state, -2, name.c_str());
+        lua_pop(vm.m_state.state, 1);
     }
 }
\ No newline at end of file
@@ -19,7 +19,6 @@
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 namespace LuaConnect
 {
-    class State;
     class VM;
     class Table;
 }
@@ -36,6 +35,8 @@ namespace LuaConnect
         friend class Stack;
         template <typename T>
         friend class Type;
+        template <typename T>
+        friend class UserdataArg;
 
     ///////////////////////////////////////////////////////////////////////////////////////////////
     /// Static Members
@@ -43,6 +44,13 @@ namespace LuaConnect
     public:
         static Userdata<T> CreateCopy(VM& vm, const T& value);
         static Userdata<T> CreateRef(VM& vm, const T& value);
+        static Userdata<T> CreateMove(VM& vm, T&& value);
+        template <typename... Args>
+        static Userdata<T> Emplace(VM& vm, Args&&... args);
+
+        static Userdata<T> CreateShared(VM& vm, std::shared_ptr<T> value);
+        static Userdata<T> CreateUnique(VM& vm, std::unique_ptr<T> value);
+        static Userdata<T> CreateOwned(VM& vm, T* value);
 
         template <typename U>
         static Userdata<T> CreateCustomCopy(VM& vm, const T& value);
@@ -51,18 +59,28 @@ namespace LuaConnect
         static Userdata<T> CreateCustomRef(VM& vm, const T& value);
         static Userdata<T> CreateCustomRef(VM& vm, const T& value, const Table& metatable);
 
+    private:
+        template <typename... Args>
+        static void PushNew(StateView state, Args&&... args);
+        static void PushRef(StateView state, T* value);
+        template <typename Holder>
+        static void PushHolder(StateView state, Holder&& holder);
+        static Userdata<T> CreateCustomCopy(VM& vm, const T& value, const Table& metatable, lua_CFunction release);
+        static void SetNewMetatable(StateView state, bool needsGC);
+
     ///////////////////////////////////////////////////////////////////////////////////////////////
     /// Members
     ///////////////////////////////////////////////////////////////////////////////////////////////
     private:
-        Userdata(std::shared_ptr<State> state);
+        Userdata(StateView state);
         template <typename... Args>
-        Userdata(std::shared_ptr<State> state, std::tuple<const Args&...> args);
+        Userdata(StateView state, std::tuple<Args...> args);
 
         void SetMetatable(const Table& metatable);
 
     public:
         Userdata();
+        Userdata(const Userdata<T>& other);
         Userdata(Userdata<T>&& other);
         template <typename... Args>
         Userdata(VM& vm, const Args&... args);
@@ -72,7 +90,7 @@ namespace LuaConnect
         bool operator==(const Userdata<T>& rhs) const;
         bool operator!=(const Userdata<T>& rhs) const;
 
-        T* GetPointer();
+        T* GetPointer() const;
     };
 }
 
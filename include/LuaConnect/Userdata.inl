@@ -8,6 +8,7 @@
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 #include "Helpers\Balance.h"
 #include "Helpers\Headers.h"
+#include "Helpers\UserdataHeader.h"
 #include "VM.h"
 #include "Type.h"
 
@@ -24,115 +25,242 @@ namespace LuaConnect
     template <typename T>
     Userdata<T> Userdata<T>::CreateRef(VM& vm, const T& value)
     {
-        return CreateCustomRef<T>(vm, value);
+        Balance b(vm.m_state, 0);
+
+        PushRef(vm.m_state, const_cast<T*>(&value));
+        return Userdata<T>(vm.m_state);
+    }
+
+    template <typename T>
+    Userdata<T> Userdata<T>::CreateMove(VM& vm, T&& value)
+    {
+        Balance b(vm.m_state, 0);
+
+        PushNew(vm.m_state, std::move(value));
+        return Userdata<T>(vm.m_state);
+    }
+    template <typename T>
+    template <typename... Args>
+    Userdata<T> Userdata<T>::Emplace(VM& vm, Args&&... args)
+    {
+        Balance b(vm.m_state, 0);
+
+        PushNew(vm.m_state, std::forward<Args>(args)...);
+        return Userdata<T>(vm.m_state);
+    }
+
+    template <typename T>
+    Userdata<T> Userdata<T>::CreateShared(VM& vm, std::shared_ptr<T> value)
+    {
+        Balance b(vm.m_state, 0);
+
+        PushHolder(vm.m_state, std::move(value));
+        return Userdata<T>(vm.m_state);
+    }
+    template <typename T>
+    Userdata<T> Userdata<T>::CreateUnique(VM& vm, std::unique_ptr<T> value)
+    {
+        Balance b(vm.m_state, 0);
+
+        PushHolder(vm.m_state, std::move(value));
+        return Userdata<T>(vm.m_state);
+    }
+    template <typename T>
+    Userdata<T> Userdata<T>::CreateOwned(VM& vm, T* value)
+    {
+        return CreateUnique(vm, std::unique_ptr<T>(value));
     }
 
     template <typename T>
     template <typename U>
     Userdata<T> Userdata<T>::CreateCustomCopy(VM& vm, const T& value)
     {
-        Balance b(m_state, 0);
+        static_assert(std::is_same<U, T>::value || std::is_base_of<U, T>::value, "Copies can only take the metatable of their own type or one of its bases.");
+
+        Balance b(vm.m_state, 0);
 
-        return CreateCustomCopy(vm, value, Type<U>::Metatable(vm.m_state));
+        // The base's __gc only accepts types registered as deriving from it
+        if (!std::is_same<U, T>::value && Type<T>::ClassKey()->Find(Type<U>::ClassKey()) < 0)
+            throw LuaException("Type has not been registered as deriving from the metatable's type.");
+
+        return CreateCustomCopy(vm, value, Type<U>::GetMetatable(vm.m_state), &Type<U>::Deconstruct);
     }
     template <typename T>
     Userdata<T> Userdata<T>::CreateCustomCopy(VM& vm, const T& value, const Table& metatable)
+    {
+        return CreateCustomCopy(vm, value, metatable, &Type<T>::Deconstruct);
+    }
+    template <typename T>
+    template <typename U>
+    Userdata<T> Userdata<T>::CreateCustomRef(VM& vm, const T& value)
+    {
+        Balance b(vm.m_state, 0);
+
+        return CreateCustomRef(vm, value, Type<U>::GetMetatable(vm.m_state));
+    }
+    template <typename T>
+    Userdata<T> Userdata<T>::CreateCustomRef(VM& vm, const T& value, const Table& metatable)
     {
         Balance b(vm.m_state, 0);
 
-        T* data = static_cast<T*>(lua_newuserdata(vm.m_state->state, sizeof(T)));
-        new (data)T(value);
+        UserdataHeader::AllocateRef(vm.m_state.state, const_cast<T*>(&value));
 
         Userdata<T> userdata(vm.m_state);
         userdata.SetMetatable(metatable);
 
         return userdata;
     }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Userdata - Private Static Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
     template <typename T>
-    template <typename U>
-    Userdata<T> Userdata<T>::CreateCustomRef(VM& vm, const T& value)
+    template <typename... Args>
+    void Userdata<T>::PushNew(StateView state, Args&&... args)
     {
-        Balance b(m_state, 0);
+        T* userdata = UserdataHeader::Allocate<T>(state.state);
 
-        return CreateCustomRef(vm, value, Type<U>::GetMetatable(vm.m_state));
+        // Construct in place, the metatable (and with it __gc) is only set once this succeeds
+        try
+        {
+            new (userdata)T(std::forward<Args>(args)...);
+        }
+        catch (const std::exception& e)
+        {
+            lua_pop(state.state, 1);
+            throw LuaException(std::string("Exception during construction: ") + e.what());
+        }
+        catch (...)
+        {
+            lua_pop(state.state, 1);
+            throw LuaException("Unknown exception during construction.");
+        }
+
+        SetNewMetatable(state, false);
     }
     template <typename T>
-    Userdata<T> Userdata<T>::CreateCustomRef(VM& vm, const T& value, const Table& metatable)
+    void Userdata<T>::PushRef(StateView state, T* value)
     {
-        Balance b(vm.m_state, 0);
+        UserdataHeader::AllocateRef(state.state, value);
+        SetNewMetatable(state, false);
+    }
+    template <typename T>
+    template <typename Holder>
+    void Userdata<T>::PushHolder(StateView state, Holder&& holder)
+    {
+        if (!holder)
+            throw LuaException("Cannot create userdata from a null pointer.");
+
+        // The holder lives in the userdata, with the header pointing straight at the object it owns
+        T* object = holder.get();
+
+        Holder* storage = UserdataHeader::Allocate<T, Holder>(state.state);
+        new (storage)Holder(std::move(holder));
 
-        lua_pushlightuserdata(vm.m_state->state, (void*)&value);
+        static_cast<UserdataHeader*>(lua_touserdata(state.state, -1))->object = object;
 
+        SetNewMetatable(state, std::is_trivially_destructible<T>::value);
+    }
+    template <typename T>
+    Userdata<T> Userdata<T>::CreateCustomCopy(VM& vm, const T& value, const Table& metatable, lua_CFunction release)
+    {
+        Balance b(vm.m_state, 0);
+
+        // Construct with the type's own metatable first, so the copy is still collected if the checks below fail
+        PushNew(vm.m_state, value);
         Userdata<T> userdata(vm.m_state);
+
+        // Objects needing destruction can only take a metatable whose __gc releases them
+        if constexpr (!std::is_trivially_destructible<T>::value)
+        {
+            Stack<Table>::Push(vm.m_state, metatable);
+            lua_pushliteral(vm.m_state.state, "__gc");
+            lua_rawget(vm.m_state.state, -2);
+            lua_CFunction gc = lua_tocfunction(vm.m_state.state, -1);
+            lua_pop(vm.m_state.state, 2);
+
+            if (gc != &Type<T>::Deconstruct && gc != release)
+                throw LuaException("Metatable has no __gc able to release the copied object.");
+        }
+
         userdata.SetMetatable(metatable);
 
         return userdata;
     }
+    template <typename T>
+    void Userdata<T>::SetNewMetatable(StateView state, bool needsGC)
+    {
+        // Set the metatable straight from the registry, leaving the userdata on the stack without a reference
+        lua_rawgetp(state.state, LUA_REGISTRYINDEX, Type<T>::ClassKey());
+        if (lua_isnil(state.state, -1))
+        {
+            // Nothing will collect what was just stored, so release it here
+            UserdataHeader* header = static_cast<UserdataHeader*>(lua_touserdata(state.state, -2));
+            if (header->release != nullptr)
+                header->release(header);
+
+            lua_pop(state.state, 2);
+            throw LuaException("Type has not been registered with Lua.");
+        }
+
+        // Types without a destructor skip __gc, so add it once the first holder needs releasing
+        if (needsGC)
+        {
+            lua_pushliteral(state.state, "__gc");
+            lua_rawget(state.state, -2);
+            if (lua_isnil(state.state, -1))
+            {
+                lua_pushcfunction(state.state, &Type<T>::Deconstruct);
+                lua_setfield(state.state, -3, "__gc");
+            }
+            lua_pop(state.state, 1);
+        }
+
+        lua_setmetatable(state.state, -2);
+    }
 
     ///////////////////////////////////////////////////////////////////////////////////////////////
     /// Userdata - Private Members
     ///////////////////////////////////////////////////////////////////////////////////////////////
     template <typename T>
-    Userdata<T>::Userdata() : Ref(std::shared_ptr<State>())
+    Userdata<T>::Userdata() : Ref(StateView())
     { }
     template <typename T>
-    Userdata<T>::Userdata(std::shared_ptr<State> state) : Ref(state)
+    Userdata<T>::Userdata(StateView state) : Ref(state)
     {
         Balance b(m_state, -1);
 
-        if (!lua_isuserdata(state->state, -1))
+        if (!lua_isuserdata(state.state, -1))
         {
-            std::string name = lua_typename(state->state, lua_type(state->state, -1));
-            lua_pop(state->state, 1);
+            std::string name = lua_typename(state.state, lua_type(state.state, -1));
+            lua_pop(state.state, 1);
 
             throw LuaException("Object at top of stack is not Userdata (is " + name + ").");
         }
 
-        // Get the metatable of the object on top of the stack;
-        lua_getmetatable(state->state, -1);
-
-        Table meta(state);
-
-        // Get the metatable we expect
-        Table expected = Type<T>::GetMetatable(state);
-            
-        // Compare actual to expected
-        if (meta != expected)
+        // Compare the type stored in the userdata header to the one expected
+        if (UserdataHeader::Check<T>(state.state, -1) == nullptr)
         {
-            lua_pop(state->state, 1);
-            throw LuaException("Object at top of stack has wrong metatable.");
+            lua_pop(state.state, 1);
+            throw LuaException("Object at top of stack has wrong type.");
         }
 
-        int ref = luaL_ref(state->state, LUA_REGISTRYINDEX);
+        int ref = luaL_ref(state.state, LUA_REGISTRYINDEX);
         Ref::Set(ref);
     }
     template <typename T>
     template <typename... Args>
-    Userdata<T>::Userdata(std::shared_ptr<State> state, std::tuple<const Args&...> args) : Ref(state)
+    Userdata<T>::Userdata(StateView state, std::tuple<Args...> args) : Ref(state)
     {
         Balance b(state, 0);
 
-        T* userdata = static_cast<T*>(lua_newuserdata(state->state, sizeof(T)));
-
-        try
-        {
-            Template::Place(userdata, args);
-        }
-        catch (const std::exception& e)
+        std::apply([&](auto&&... values)
         {
-            lua_pop(state->state, 1);
-            throw LuaException(std::string("Exception during construction: ") + e.what());
-        }
-        catch (...)
-        {
-            lua_pop(state->state, 1);
-            throw LuaException("Unknown exception during construction.");
-        }
+            PushNew(state, std::forward<decltype(values)>(values)...);
+        }, std::move(args));
 
-        int ref = luaL_ref(state->state, LUA_REGISTRYINDEX);
+        int ref = luaL_ref(state.state, LUA_REGISTRYINDEX);
         Ref::Set(ref);
-
-        SetMetatable(Type<T>::GetMetatable(state));
     }
 
     template <typename T>
@@ -143,20 +271,23 @@ namespace LuaConnect
         Stack<Userdata<T>>::Push(m_state, *this);
         Stack<Table>::Push(m_state, metatable);
 
-        lua_setmetatable(m_state->state, -2);
+        lua_setmetatable(m_state.state, -2);
 
-        lua_pop(m_state->state, 1);
+        lua_pop(m_state.state, 1);
     }
 
     ///////////////////////////////////////////////////////////////////////////////////////////////
     /// Userdata - Public Members
     ///////////////////////////////////////////////////////////////////////////////////////////////
     template <typename T>
+    Userdata<T>::Userdata(const Userdata<T>& other) : Ref(other)
+    { }
+    template <typename T>
     Userdata<T>::Userdata(Userdata<T>&& other) : Ref(static_cast<Ref&&>(other))
     { }
     template <typename T>
     template <typename... Args>
-    Userdata<T>::Userdata(VM& vm, const Args&... args) : Userdata(vm.m_state, std::tuple<const Args&...>(args...))
+    Userdata<T>::Userdata(VM& vm, const Args&... args) : Userdata(vm.m_state, std::forward_as_tuple(args...))
     { }
 
     template <typename T>
@@ -178,14 +309,14 @@ namespace LuaConnect
     }
 
     template <typename T>
-    T* Userdata<T>::GetPointer()
+    T* Userdata<T>::GetPointer() const
     {
         Balance b(m_state, 0);
 
         Ref::Push();
-        T* result = static_cast<T*>(lua_touserdata(m_state->state, -1));
+        T* result = UserdataHeader::Check<T>(m_state.state, -1);
 
-        lua_pop(m_state->state, 1);
+        lua_pop(m_state.state, 1);
 
         return result;
     }
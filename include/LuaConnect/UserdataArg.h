@@ -0,0 +1,52 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// LuaConnect/UserdataArg.h
+///////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef LUACONNECT_USERDATAARG
+#define LUACONNECT_USERDATAARG
+
+#include "Config.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Preprocessor
+///////////////////////////////////////////////////////////////////////////////////////////////////
+#include "Helpers\Slot.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Forward Declarations
+///////////////////////////////////////////////////////////////////////////////////////////////////
+namespace LuaConnect
+{
+    template <typename T>
+    class Userdata;
+}
+
+namespace LuaConnect
+{
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Class - UserdataArg
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    class LUACONNECT_API UserdataArg : private Slot
+    {
+        template <typename T>
+        friend class Stack;
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    private:
+        UserdataArg(StateView state, int index);
+
+    public:
+        T* GetPointer() const;
+
+        Userdata<T> Promote() const;
+    };
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Inline Includes
+///////////////////////////////////////////////////////////////////////////////////////////////////
+#include "UserdataArg.inl"
+
+#endif LUACONNECT_USERDATAARG
@@ -0,0 +1,52 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// LuaConnect/UserdataArg.inl
+///////////////////////////////////////////////////////////////////////////////////////////////////
+#include "UserdataArg.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Preprocessor
+///////////////////////////////////////////////////////////////////////////////////////////////////
+#include "Exceptions\LuaException.h"
+#include "Helpers\Headers.h"
+#include "Helpers\UserdataHeader.h"
+#include "Type.h"
+#include "Userdata.h"
+
+#include <string>
+
+namespace LuaConnect
+{
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// UserdataArg - Private Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    UserdataArg<T>::UserdataArg(StateView state, int index) : Slot(state, index)
+    {
+        if (!lua_isuserdata(state.state, m_index))
+        {
+            std::string name = lua_typename(state.state, lua_type(state.state, m_index));
+            throw LuaException("Object at index " + std::to_string(m_index) + " is not Userdata (is " + name + ").");
+        }
+
+        // Compare the type stored in the userdata header to the one expected
+        if (UserdataHeader::Check<T>(state.state, m_index) == nullptr)
+            throw LuaException("Object at index " + std::to_string(m_index) + " has wrong type.");
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// UserdataArg - Public Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    T* UserdataArg<T>::GetPointer() const
+    {
+        return UserdataHeader::Check<T>(m_state.state, m_index);
+    }
+
+    template <typename T>
+    Userdata<T> UserdataArg<T>::Promote() const
+    {
+        // Take a reference to the value, so it can outlive the call
+        Slot::Push();
+        return Userdata<T>(m_state);
+    }
+}
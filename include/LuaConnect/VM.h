@@ -11,6 +11,7 @@
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 #include "Function.h"
 #include "Helpers\NonCopyable.h"
+#include "Helpers\StateView.h"
 
 #include <memory>
 #include <string>
@@ -33,8 +34,11 @@ namespace LuaConnect
     class LUACONNECT_API VM
     {
         friend class Function;
+        friend class Key;
         friend Table;
 
+        template <typename T>
+        friend class BufferView;
         template <typename T>
         friend class Type;
         template <typename T>
@@ -44,7 +48,8 @@ namespace LuaConnect
     /// Members
     ///////////////////////////////////////////////////////////////////////////////////////////////
     private:
-        std::shared_ptr<State> m_state;
+        std::shared_ptr<State> m_owner;
+        StateView m_state;
 
     public:
         VM();
@@ -0,0 +1,36 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// LuaConnect/FunctionArg.cpp
+///////////////////////////////////////////////////////////////////////////////////////////////////
+#include "LuaConnect\FunctionArg.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Preprocessor
+///////////////////////////////////////////////////////////////////////////////////////////////////
+#include "LuaConnect\Exceptions\LuaException.h"
+#include "LuaConnect\Function.h"
+#include "LuaConnect\Helpers\Headers.h"
+
+namespace LuaConnect
+{
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// FunctionArg - Private Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    FunctionArg::FunctionArg(StateView state, int index) : Slot(state, index)
+    {
+        if (!lua_isfunction(state.state, m_index))
+        {
+            std::string name = lua_typename(state.state, lua_type(state.state, m_index));
+            throw LuaException("Object at index " + std::to_string(m_index) + " is not a Function (is " + name + ").");
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// FunctionArg - Public Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    Function FunctionArg::Promote() const
+    {
+        // Take a reference to the value, so it can outlive the call
+        Slot::Push();
+        return Function(m_state);
+    }
+}
@@ -7,22 +7,29 @@
 /// Preprocessor
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 #include "LuaConnect\Helpers\Headers.h"
-#include "LuaConnect\Helpers\State.h"
 
 #include <assert.h>
+#include <exception>
 
 namespace LuaConnect
 {
     ///////////////////////////////////////////////////////////////////////////////////////////////
     /// Balance - Public Members
     ///////////////////////////////////////////////////////////////////////////////////////////////
-    Balance::Balance(std::shared_ptr<State> state, int delta) :
-        m_state(state), m_initial(lua_gettop(m_state->state)), m_delta(delta)
+    Balance::Balance(StateView state, int delta) :
+        m_state(state), m_initial(lua_gettop(m_state.state)), m_delta(delta), m_exceptions(std::uncaught_exceptions())
     { }
     Balance::~Balance()
     {
+        // A throw part way through leaves whatever was pushed, so drop it rather than checking
+        if (std::uncaught_exceptions() > m_exceptions)
+        {
+            lua_settop(m_state.state, m_initial);
+            return;
+        }
+
         // Check the stack has been balanced as we were told it would be
-        int top = lua_gettop(m_state->state);
+        int top = lua_gettop(m_state.state);
         assert(top == m_initial + m_delta);
     }
 }
\ No newline at end of file
@@ -7,7 +7,6 @@
 /// Preprocessor
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 #include "LuaConnect\Helpers\Headers.h"
-#include "LuaConnect\Helpers\State.h"
 
 #include <assert.h>
 
@@ -16,13 +15,13 @@ namespace LuaConnect
     ///////////////////////////////////////////////////////////////////////////////////////////////
     /// Ref - Protected Members
     ///////////////////////////////////////////////////////////////////////////////////////////////
-    Ref::Ref(std::shared_ptr<State> state) : m_state(state), m_ref(LUA_NOREF)
+    Ref::Ref(StateView state) : m_state(state), m_ref(LUA_NOREF)
     { }
 
     Ref::Ref(const Ref& other) : m_state(other.m_state), m_ref(LUA_NOREF)
     {
         other.Push();
-        m_ref = luaL_ref(m_state->state, LUA_REGISTRYINDEX);
+        m_ref = luaL_ref(m_state.state, LUA_REGISTRYINDEX);
     }
     Ref::Ref(Ref&& other) : m_state(other.m_state), m_ref(other.m_ref)
     {
@@ -32,7 +31,7 @@ namespace LuaConnect
     Ref::~Ref()
     {
         if (m_ref != LUA_NOREF)
-            luaL_unref(m_state->state, LUA_REGISTRYINDEX, m_ref);
+            luaL_unref(m_state.state, LUA_REGISTRYINDEX, m_ref);
     }
 
     Ref& Ref::operator=(const Ref& other)
@@ -40,7 +39,7 @@ namespace LuaConnect
         m_state = other.m_state;
 
         other.Push();
-        m_ref = luaL_ref(m_state->state, LUA_REGISTRYINDEX);
+        m_ref = luaL_ref(m_state.state, LUA_REGISTRYINDEX);
 
         return *this;
     }
@@ -59,8 +58,8 @@ namespace LuaConnect
         Push();
         rhs.Push();
 
-        int comp = lua_compare(m_state->state, -2, -1, LUA_OPEQ);
-        lua_pop(m_state->state, 2);
+        int comp = lua_compare(m_state.state, -2, -1, LUA_OPEQ);
+        lua_pop(m_state.state, 2);
 
         return (comp == 1);
     }
@@ -71,13 +70,13 @@ namespace LuaConnect
 
     void Ref::Push() const
     {
-        lua_rawgeti(m_state->state, LUA_REGISTRYINDEX, m_ref);
+        lua_rawgeti(m_state.state, LUA_REGISTRYINDEX, m_ref);
     }
     void Ref::Set(int ref)
     {
         assert(ref != LUA_REFNIL);
 
-        luaL_unref(m_state->state, LUA_REGISTRYINDEX, m_ref);
+        luaL_unref(m_state.state, LUA_REGISTRYINDEX, m_ref);
         m_ref = ref;
     }
 }
\ No newline at end of file
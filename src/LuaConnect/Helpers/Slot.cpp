@@ -0,0 +1,23 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// LuaConnect/Helpers/Slot.cpp
+///////////////////////////////////////////////////////////////////////////////////////////////////
+#include "LuaConnect\Helpers\Slot.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Preprocessor
+///////////////////////////////////////////////////////////////////////////////////////////////////
+#include "LuaConnect\Helpers\Headers.h"
+
+namespace LuaConnect
+{
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Slot - Protected Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    Slot::Slot(StateView state, int index) : m_state(state), m_index(lua_absindex(state.state, index))
+    { }
+
+    void Slot::Push() const
+    {
+        lua_pushvalue(m_state.state, m_index);
+    }
+}
@@ -6,6 +6,7 @@
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 /// Preprocessor
 ///////////////////////////////////////////////////////////////////////////////////////////////////
+#include "LuaConnect\Exceptions\LuaException.h"
 #include "LuaConnect\Helpers\Headers.h"
 
 namespace LuaConnect
@@ -13,184 +14,239 @@ namespace LuaConnect
     ///////////////////////////////////////////////////////////////////////////////////////////////
     /// Stack<Nil> - Public Members
     ///////////////////////////////////////////////////////////////////////////////////////////////
-    void Stack<Nil>::Push(std::shared_ptr<State> state)
+    void Stack<Nil>::Push(StateView state)
     {
-        lua_pushnil(state->state);
+        lua_pushnil(state.state);
     }
 
     ///////////////////////////////////////////////////////////////////////////////////////////////
     /// Stack<bool> - Public Members
     ///////////////////////////////////////////////////////////////////////////////////////////////
-    bool Stack<bool>::Get(std::shared_ptr<State> state, int index)
+    bool Stack<bool>::Get(StateView state, int index)
     {
-        return (lua_toboolean(state->state, index) == 1);
+        return (lua_toboolean(state.state, index) == 1);
     }
 
-    bool Stack<bool>::Pop(std::shared_ptr<State> state)
+    bool Stack<bool>::Pop(StateView state)
     {
         bool result = Stack<bool>::Get(state, -1);
-        lua_pop(state->state, 1);
+        lua_pop(state.state, 1);
 
         return result;
     }
-    void Stack<bool>::Push(std::shared_ptr<State> state, const bool& value)
+    void Stack<bool>::Push(StateView state, const bool& value)
     {
-        lua_pushboolean(state->state, value);
+        lua_pushboolean(state.state, value);
     }
 
     ///////////////////////////////////////////////////////////////////////////////////////////////
-    /// Stack<lua_Integer> - Public Members
+    /// Stack<const char*> - Public Members
     ///////////////////////////////////////////////////////////////////////////////////////////////
-    lua_Integer Stack<lua_Integer>::Get(std::shared_ptr<State> state, int index)
+    const char* Stack<const char*>::Get(StateView state, int index)
     {
-        return lua_tointeger(state->state, index);
+        return lua_tostring(state.state, index);
     }
 
-    lua_Integer Stack<lua_Integer>::Pop(std::shared_ptr<State> state)
-    {
-        lua_Integer result = Stack<lua_Integer>::Get(state, -1);
-        lua_pop(state->state, 1);
-
-        return result;
-    }
-    void Stack<lua_Integer>::Push(std::shared_ptr<State> state, const lua_Integer& value)
+    void Stack<const char*>::Push(StateView state, const char* value)
     {
-        lua_pushinteger(state->state, value);
+        lua_pushstring(state.state, value);
     }
 
     ///////////////////////////////////////////////////////////////////////////////////////////////
-    /// Stack<lua_Unsigned> - Public Members
+    /// Stack<std::string> - Public Members
     ///////////////////////////////////////////////////////////////////////////////////////////////
-    lua_Unsigned Stack<lua_Unsigned>::Get(std::shared_ptr<State> state, int index)
+    std::string Stack<std::string>::Get(StateView state, int index)
     {
-        return lua_tounsigned(state->state, index);
+        size_t len = 0;
+        const char* str = lua_tolstring(state.state, index, &len);
+
+        if (!str) // string constructor has undefined behaviour if str is NULL
+            return std::string();
+
+        return std::string(str, len);
     }
 
-    lua_Unsigned Stack<lua_Unsigned>::Pop(std::shared_ptr<State> state)
+    std::string Stack<std::string>::Pop(StateView state)
     {
-        lua_Unsigned result = Stack<lua_Unsigned>::Get(state, -1);
-        lua_pop(state->state, 1);
+        std::string result = Stack<std::string>::Get(state, -1);
+        lua_pop(state.state, 1);
 
         return result;
     }
-    void Stack<lua_Unsigned>::Push(std::shared_ptr<State> state, const lua_Unsigned& value)
+    void Stack<std::string>::Push(StateView state, const std::string& value)
     {
-        lua_pushunsigned(state->state, value);
+        lua_pushlstring(state.state, value.c_str(), value.size());
     }
 
     ///////////////////////////////////////////////////////////////////////////////////////////////
-    /// Stack<lua_Number> - Public Members
+    /// Stack<std::string_view> - Public Members
     ///////////////////////////////////////////////////////////////////////////////////////////////
-    lua_Number Stack<lua_Number>::Get(std::shared_ptr<State> state, int index)
+    std::string_view Stack<std::string_view>::Get(StateView state, int index)
     {
-        return lua_tonumber(state->state, index);
-    }
+        size_t len = 0;
+        const char* str = lua_tolstring(state.state, index, &len);
 
-    lua_Number Stack<lua_Number>::Pop(std::shared_ptr<State> state)
-    {
-        lua_Number result = Stack<lua_Number>::Get(state, -1);
-        lua_pop(state->state, 1);
+        if (!str)
+            return std::string_view();
 
-        return result;
-    }
-    void Stack<lua_Number>::Push(std::shared_ptr<State> state, const lua_Number& value)
-    {
-        lua_pushnumber(state->state, value);
+        return std::string_view(str, len);
     }
 
-    ///////////////////////////////////////////////////////////////////////////////////////////////
-    /// Stack<const char*> - Public Members
-    ///////////////////////////////////////////////////////////////////////////////////////////////
-    void Stack<const char*>::Push(std::shared_ptr<State> state, const char* value)
+    void Stack<std::string_view>::Push(StateView state, const std::string_view& value)
     {
-        Stack<std::string>::Push(state, std::string(value));
+        lua_pushlstring(state.state, value.data(), value.size());
     }
 
     ///////////////////////////////////////////////////////////////////////////////////////////////
-    /// Stack<std::string> - Public Members
+    /// Stack<Key> - Public Members
     ///////////////////////////////////////////////////////////////////////////////////////////////
-    std::string Stack<std::string>::Get(std::shared_ptr<State> state, int index)
+    void Stack<Key>::Push(StateView state, const Key& value)
     {
-        size_t len = 0;
-        const char* str = lua_tolstring(state->state, index, &len);
+        if (value.m_state.state == nullptr)
+            throw LuaException("Key is empty, it must be created from a VM before being pushed.");
 
-        if (!str) // string constructor has undefined behaviour if str is NULL
-            return std::string();
+        // Keys are usually pushed on the main thread, only coroutines need to look theirs up
+        if (value.m_state.state != state.state)
+        {
+            lua_rawgeti(state.state, LUA_REGISTRYINDEX, LUA_RIDX_MAINTHREAD);
+            lua_State* main = lua_tothread(state.state, -1);
+            lua_pop(state.state, 1);
 
-        return std::string(str, len);
-    }
-
-    std::string Stack<std::string>::Pop(std::shared_ptr<State> state)
-    {
-        std::string result = Stack<std::string>::Get(state, -1);
-        lua_pop(state->state, 1);
+            if (value.m_state.state != main)
+                throw LuaException("Key was created by a different VM.");
+        }
 
-        return result;
-    }
-    void Stack<std::string>::Push(std::shared_ptr<State> state, const std::string& value)
-    {
-        lua_pushlstring(state->state, value.c_str(), value.size());
+        lua_rawgeti(state.state, LUA_REGISTRYINDEX, value.m_ref);
     }
 
     ///////////////////////////////////////////////////////////////////////////////////////////////
     /// Stack<lua_CFunction> - Public Members
     ///////////////////////////////////////////////////////////////////////////////////////////////
-    lua_CFunction Stack<lua_CFunction>::Get(std::shared_ptr<State> state, int index)
+    lua_CFunction Stack<lua_CFunction>::Get(StateView state, int index)
     {
-        return lua_tocfunction(state->state, index);
+        return lua_tocfunction(state.state, index);
     }
 
-    lua_CFunction Stack<lua_CFunction>::Pop(std::shared_ptr<State> state)
+    lua_CFunction Stack<lua_CFunction>::Pop(StateView state)
     {
         lua_CFunction result = Stack<lua_CFunction>::Get(state, -1);
-        lua_pop(state->state, 1);
+        lua_pop(state.state, 1);
 
         return result;
     }
-    void Stack<lua_CFunction>::Push(std::shared_ptr<State> state, const lua_CFunction& value, int upvalueCount)
+    void Stack<lua_CFunction>::Push(StateView state, const lua_CFunction& value, int upvalueCount)
     {
-        lua_pushcclosure(state->state, value, upvalueCount);
+        lua_pushcclosure(state.state, value, upvalueCount);
     }
 
     ///////////////////////////////////////////////////////////////////////////////////////////////
     /// Stack<Function> - Public Members
     ///////////////////////////////////////////////////////////////////////////////////////////////
-    Function Stack<Function>::Get(std::shared_ptr<State> state, int index)
+    Function Stack<Function>::Get(StateView state, int index)
     {
-        lua_pushvalue(state->state, index);
+        lua_pushvalue(state.state, index);
         return Function(state);
     }
 
-    Function Stack<Function>::Pop(std::shared_ptr<State> state)
+    Function Stack<Function>::Pop(StateView state)
     {
         Function result = Stack<Function>::Get(state, -1);
-        lua_pop(state->state, 1);
+        lua_pop(state.state, 1);
 
         return result;
     }
-    void Stack<Function>::Push(std::shared_ptr<State> state, const Function& value)
+    void Stack<Function>::Push(StateView state, const Function& value)
     {
-        lua_rawgeti(state->state, LUA_REGISTRYINDEX, value.m_ref);
+        if (value.m_state.state == nullptr)
+            throw LuaException("Key is empty, it must be created from a VM before being pushed.");
+
+        // Keys are usually pushed on the main thread, only coroutines need to look theirs up
+        if (value.m_state.state != state.state)
+        {
+            lua_rawgeti(state.state, LUA_REGISTRYINDEX, LUA_RIDX_MAINTHREAD);
+            lua_State* main = lua_tothread(state.state, -1);
+            lua_pop(state.state, 1);
+
+            if (value.m_state.state != main)
+                throw LuaException("Key was created by a different VM.");
+        }
+
+        lua_rawgeti(state.state, LUA_REGISTRYINDEX, value.m_ref);
     }
 
     ///////////////////////////////////////////////////////////////////////////////////////////////
     /// Stack<Table> - Public Members
     ///////////////////////////////////////////////////////////////////////////////////////////////
-    Table Stack<Table>::Get(std::shared_ptr<State> state, int index)
+    Table Stack<Table>::Get(StateView state, int index)
     {
-        lua_pushvalue(state->state, index);
+        lua_pushvalue(state.state, index);
         return Table(state);
     }
 
-    Table Stack<Table>::Pop(std::shared_ptr<State> state)
+    Table Stack<Table>::Pop(StateView state)
     {
         Table result = Stack<Table>::Get(state, -1);
-        lua_pop(state->state, 1);
+        lua_pop(state.state, 1);
 
         return result;
     }
-    void Stack<Table>::Push(std::shared_ptr<State> state, const Table& value)
+    void Stack<Table>::Push(StateView state, const Table& value)
+    {
+        if (value.m_state.state == nullptr)
+            throw LuaException("Key is empty, it must be created from a VM before being pushed.");
+
+        // Keys are usually pushed on the main thread, only coroutines need to look theirs up
+        if (value.m_state.state != state.state)
+        {
+            lua_rawgeti(state.state, LUA_REGISTRYINDEX, LUA_RIDX_MAINTHREAD);
+            lua_State* main = lua_tothread(state.state, -1);
+            lua_pop(state.state, 1);
+
+            if (value.m_state.state != main)
+                throw LuaException("Key was created by a different VM.");
+        }
+
+        lua_rawgeti(state.state, LUA_REGISTRYINDEX, value.m_ref);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Stack<FunctionArg> - Public Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    FunctionArg Stack<FunctionArg>::Get(StateView state, int index)
     {
-        lua_rawgeti(state->state, LUA_REGISTRYINDEX, value.m_ref);
+        return FunctionArg(state, index);
+    }
+
+    void Stack<FunctionArg>::Push(StateView state, const FunctionArg& value)
+    {
+        lua_pushvalue(state.state, value.m_index);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Stack<TableArg> - Public Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    TableArg Stack<TableArg>::Get(StateView state, int index)
+    {
+        return TableArg(state, index);
+    }
+
+    void Stack<TableArg>::Push(StateView state, const TableArg& value)
+    {
+        lua_pushvalue(state.state, value.m_index);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// StackHelper - Public Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    int StackHelper::CheckTable(StateView state, int index)
+    {
+        if (!lua_istable(state.state, index))
+        {
+            std::string name = lua_typename(state.state, lua_type(state.state, index));
+            throw LuaException("Object at index " + std::to_string(index) + " is not a Table (is " + name + ").");
+        }
+
+        // Elements are pushed while reading, so relative indices would move
+        return lua_absindex(state.state, index);
     }
 }
\ No newline at end of file
@@ -13,16 +13,13 @@ namespace LuaConnect
     ///////////////////////////////////////////////////////////////////////////////////////////////
     /// State - Public Members
     ///////////////////////////////////////////////////////////////////////////////////////////////
-    State::State() : m_managed(true), state(luaL_newstate())
+    State::State() : state(luaL_newstate())
     {
         luaL_openlibs(state);
     }
-    State::State(lua_State* state) : m_managed(false), state(state)
-    { }
 
     State::~State()
     {
-        if (m_managed)
-            lua_close(state);
+        lua_close(state);
     }
 }
\ No newline at end of file
@@ -0,0 +1,44 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// LuaConnect/Helpers/TypeInfo.cpp
+///////////////////////////////////////////////////////////////////////////////////////////////////
+#include "LuaConnect\Helpers\TypeInfo.h"
+
+namespace LuaConnect
+{
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// TypeInfo - Private Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    void* TypeInfo::CastAt(void* object, int index) const
+    {
+        const Ancestor& ancestor = ancestors[index];
+
+        // Walk down through the intermediate base first, so each cast applies its own adjustment
+        if (ancestor.via >= 0)
+            object = CastAt(object, ancestor.via);
+
+        return ancestor.cast(object);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// TypeInfo - Public Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    int TypeInfo::Find(const TypeInfo* type) const
+    {
+        for (std::size_t i = 0; i < ancestors.size(); ++i)
+        {
+            if (ancestors[i].type == type)
+                return static_cast<int>(i);
+        }
+
+        return -1;
+    }
+
+    void* TypeInfo::Cast(void* object, const TypeInfo* type) const
+    {
+        if (type == this)
+            return object;
+
+        int index = Find(type);
+        return (index >= 0 ? CastAt(object, index) : nullptr);
+    }
+}
@@ -0,0 +1,39 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// LuaConnect/Helpers/UserdataHeader.cpp
+///////////////////////////////////////////////////////////////////////////////////////////////////
+#include "LuaConnect\Helpers\UserdataHeader.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Preprocessor
+///////////////////////////////////////////////////////////////////////////////////////////////////
+#include "LuaConnect\Helpers\Headers.h"
+
+namespace LuaConnect
+{
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// UserdataHeader - Public Static Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    UserdataHeader* UserdataHeader::Get(lua_State* state, int index)
+    {
+        // Only full userdata large enough to hold a header, and marked as ours, can be read as one
+        if (lua_type(state, index) != LUA_TUSERDATA || lua_rawlen(state, index) < sizeof(UserdataHeader))
+            return nullptr;
+
+        UserdataHeader* header = static_cast<UserdataHeader*>(lua_touserdata(state, index));
+        return (header->magic == Magic ? header : nullptr);
+    }
+
+    void* UserdataHeader::GetObject(lua_State* state, int index)
+    {
+        UserdataHeader* header = Get(state, index);
+        return (header != nullptr ? header->object : nullptr);
+    }
+    void* UserdataHeader::GetObject(lua_State* state, int index, const TypeInfo* type)
+    {
+        UserdataHeader* header = Get(state, index);
+        if (header == nullptr)
+            return nullptr;
+
+        return header->type->Cast(header->object, type);
+    }
+}
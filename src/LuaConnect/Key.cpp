@@ -0,0 +1,80 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// LuaConnect/Key.cpp
+///////////////////////////////////////////////////////////////////////////////////////////////////
+#include "LuaConnect\Key.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Preprocessor
+///////////////////////////////////////////////////////////////////////////////////////////////////
+#include "LuaConnect\Helpers\Balance.h"
+#include "LuaConnect\Helpers\Headers.h"
+#include "LuaConnect\VM.h"
+
+namespace LuaConnect
+{
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Key - Private Static Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    unsigned char Key::s_cache = 0;
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// Key - Public Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    Key::Key() : m_ref(LUA_REFNIL)
+    { }
+    Key::Key(VM& vm, std::string_view name) : m_ref(LUA_REFNIL)
+    {
+        lua_State* state = vm.m_state.state;
+
+        Balance b(vm.m_state, 0);
+
+        // Remember the main thread, which any coroutine of the same VM shares its registry with
+        lua_rawgeti(state, LUA_REGISTRYINDEX, LUA_RIDX_MAINTHREAD);
+        m_state = lua_tothread(state, -1);
+        lua_pop(state, 1);
+
+        // Get the cache of interned strings from the registry, creating it on first use
+        lua_rawgetp(state, LUA_REGISTRYINDEX, &s_cache);
+        if (lua_isnil(state, -1))
+        {
+            lua_pop(state, 1);
+            lua_newtable(state);
+
+            lua_pushvalue(state, -1);
+            lua_rawsetp(state, LUA_REGISTRYINDEX, &s_cache);
+        }
+
+        // Reuse the registry slot of an existing key for the same string
+        lua_pushlstring(state, name.data(), name.size());
+        lua_pushvalue(state, -1);
+        lua_rawget(state, -3);
+
+        if (lua_isnumber(state, -1))
+        {
+            m_ref = static_cast<int>(lua_tointeger(state, -1));
+            lua_pop(state, 3);
+
+            return;
+        }
+
+        lua_pop(state, 1);
+
+        // Otherwise take a new slot, remembering it in the cache
+        lua_pushvalue(state, -1);
+        m_ref = luaL_ref(state, LUA_REGISTRYINDEX);
+
+        lua_pushinteger(state, m_ref);
+        lua_rawset(state, -3);
+        lua_pop(state, 1);
+    }
+
+    bool Key::operator==(const Key& rhs) const
+    {
+        // Keys for the same string always share a slot within a VM
+        return (m_state.state == rhs.m_state.state && m_ref == rhs.m_ref);
+    }
+    bool Key::operator!=(const Key& rhs) const
+    {
+        return !operator==(rhs);
+    }
+}
@@ -14,26 +14,28 @@ namespace LuaConnect
     ///////////////////////////////////////////////////////////////////////////////////////////////
     /// Table - Private Members
     ///////////////////////////////////////////////////////////////////////////////////////////////
-    Table::Table(std::shared_ptr<State> state) : Ref(state)
+    Table::Table(StateView state) : Ref(state)
     {
         Balance b(m_state, -1);
 
-        if (!lua_istable(state->state, -1))
+        if (!lua_istable(state.state, -1))
         {
-            std::string name = lua_typename(state->state, lua_type(state->state, -1));
-            lua_pop(state->state, 1);
+            std::string name = lua_typename(state.state, lua_type(state.state, -1));
+            lua_pop(state.state, 1);
 
             throw LuaException("Object at top of stack is not a Table (is " + name + ").");
         }
 
-        int ref = luaL_ref(state->state, LUA_REGISTRYINDEX);
+        int ref = luaL_ref(state.state, LUA_REGISTRYINDEX);
         Ref::Set(ref);
     }
 
     ///////////////////////////////////////////////////////////////////////////////////////////////
     /// Table - Public Members
     ///////////////////////////////////////////////////////////////////////////////////////////////
-    Table::Table() : Ref(std::shared_ptr<State>())
+    Table::Table() : Ref(StateView())
+    { }
+    Table::Table(const Table& other) : Ref(other)
     { }
     Table::Table(Table&& other) : Ref(static_cast<Ref&&>(other))
     { }
@@ -41,9 +43,9 @@ namespace LuaConnect
     {
         Balance b(m_state, 0);
 
-        lua_newtable(vm.m_state->state);
+        lua_newtable(vm.m_state.state);
 
-        int ref = luaL_ref(vm.m_state->state, LUA_REGISTRYINDEX);
+        int ref = luaL_ref(vm.m_state.state, LUA_REGISTRYINDEX);
         Ref::Set(ref);
     }
 
@@ -0,0 +1,36 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// LuaConnect/TableArg.cpp
+///////////////////////////////////////////////////////////////////////////////////////////////////
+#include "LuaConnect\TableArg.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Preprocessor
+///////////////////////////////////////////////////////////////////////////////////////////////////
+#include "LuaConnect\Exceptions\LuaException.h"
+#include "LuaConnect\Helpers\Headers.h"
+#include "LuaConnect\Table.h"
+
+namespace LuaConnect
+{
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// TableArg - Private Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    TableArg::TableArg(StateView state, int index) : Slot(state, index)
+    {
+        if (!lua_istable(state.state, m_index))
+        {
+            std::string name = lua_typename(state.state, lua_type(state.state, m_index));
+            throw LuaException("Object at index " + std::to_string(m_index) + " is not a Table (is " + name + ").");
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// TableArg - Public Members
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    Table TableArg::Promote() const
+    {
+        // Take a reference to the value, so it can outlive the call
+        Slot::Push();
+        return Table(m_state);
+    }
+}
@@ -3,45 +3,91 @@
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 #include "LuaConnect\Type.h"
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Preprocessor
+///////////////////////////////////////////////////////////////////////////////////////////////////
+#include "LuaConnect\Exceptions\LuaException.h"
+#include "LuaConnect\Helpers\Headers.h"
+#include "LuaConnect\Helpers\UserdataHeader.h"
+
 namespace LuaConnect
 {
     ///////////////////////////////////////////////////////////////////////////////////////////////
     /// UserdataMeta - Public Static Members
     ///////////////////////////////////////////////////////////////////////////////////////////////
-    int GenericMeta::DummyDeconstruct(lua_State* state)
-    {
-        return 0;
-    }
-
     int GenericMeta::Index(lua_State* state)
     {
-        lua_getmetatable(state, 1);
+        // Methods take priority, and are found with a single raw get in the functions table
+        lua_pushvalue(state, 2);
+        lua_rawget(state, lua_upvalueindex(1));
+        if (!lua_isnil(state, -1))
+            return 1;
 
-        // Load the 'methods' table in the userdata metatable
-        lua_pushstring(state, "__functions");
-        lua_rawget(state, -2);
+        lua_pop(state, 1);
 
-        // Try loading the name in the userdata 'methods' table
+        // Otherwise look for a property, reading it straight out of the object
         lua_pushvalue(state, 2);
-        lua_rawget(state, -2);
+        lua_rawget(state, lua_upvalueindex(2));
+
+        const Property* property = static_cast<const Property*>(lua_touserdata(state, -1));
+        if (property == nullptr)
+            return 1;
+
+        lua_pop(state, 1);
+
+        // The metatable isn't protected, so __index may be called by hand with another type's object
+        void* object = UserdataHeader::GetObject(state, 1, property->type);
+        if (object == nullptr)
+            return luaL_error(state, "Argument 1 is not the expected userdata type.");
+
+        try
+        {
+            property->get(state, object, property);
+        }
+        catch (const LuaException& e)
+        {
+            return luaL_error(state, "%s", e.what());
+        }
 
         return 1;
     }
     int GenericMeta::NewIndex(lua_State* state)
     {
+        // Look for a property in the properties table
+        lua_pushvalue(state, 2);
+        lua_rawget(state, lua_upvalueindex(1));
+
+        const Property* property = static_cast<const Property*>(lua_touserdata(state, -1));
+        if (property == nullptr)
+            return luaL_error(state, "Cannot assign to '%s', it is not a property.", lua_tostring(state, 2));
+        if (property->set == nullptr)
+            return luaL_error(state, "Cannot assign to '%s', the property is read only.", lua_tostring(state, 2));
+
+        lua_pop(state, 1);
+
+        void* object = UserdataHeader::GetObject(state, 1, property->type);
+        if (object == nullptr)
+            return luaL_error(state, "Argument 1 is not the expected userdata type.");
+
+        try
+        {
+            property->set(state, object, property, 3);
+        }
+        catch (const LuaException& e)
+        {
+            return luaL_error(state, "%s", e.what());
+        }
+
         return 0;
     }
 
     int GenericMeta::ToString(lua_State* state)
     {
-        // Create the State needed for calls to C++ code
-        std::shared_ptr<State> luaState(new State(state));
-
+        // Read the name straight out of the metatable, leaving Lua to build the string
         lua_getmetatable(state, -1);
-        Table meta = Stack<Table>::Pop(luaState);
+        lua_getfield(state, -1, "__name");
 
-        std::string str = "userdata: " + meta.Get<std::string>("__name");
-        Stack<std::string>::Push(luaState, str);
+        lua_pushfstring(state, "userdata: %s", lua_tostring(state, -1));
 
         return 1;
     }
@@ -15,14 +15,14 @@ namespace LuaConnect
     ///////////////////////////////////////////////////////////////////////////////////////////////
     /// VM - Public Members
     ///////////////////////////////////////////////////////////////////////////////////////////////
-    VM::VM() : m_state(new State())
+    VM::VM() : m_owner(new State()), m_state(m_owner->state)
     { }
 
     Table VM::GetGlobalTable()
     {
         Balance b(m_state, 0);
 
-        lua_rawgeti(m_state->state, LUA_REGISTRYINDEX, LUA_RIDX_GLOBALS);
+        lua_rawgeti(m_state.state, LUA_REGISTRYINDEX, LUA_RIDX_GLOBALS);
         return Stack<Table>::Pop(m_state);
     }
 
@@ -30,7 +30,7 @@ namespace LuaConnect
     {
         Balance b(m_state, 0);
 
-        int err = luaL_loadbufferx(m_state->state, buffer.c_str(), buffer.size(), "buffer", "t");
+        int err = luaL_loadbufferx(m_state.state, buffer.c_str(), buffer.size(), "buffer", "t");
         if (err != LUA_OK)
         {
             std::string errStr = Stack<std::string>::Pop(m_state);
@@ -48,7 +48,7 @@ namespace LuaConnect
         if (environment)
         {
             Stack<Table>::Push(m_state, *environment);
-            lua_setupvalue(m_state->state, -2, 1);
+            lua_setupvalue(m_state.state, -2, 1);
         }
 
         return Stack<Function>::Pop(m_state);
@@ -57,7 +57,7 @@ namespace LuaConnect
     {
         Balance b(m_state, 0);
 
-        int err = luaL_loadfilex(m_state->state, filename.c_str(), "t");
+        int err = luaL_loadfilex(m_state.state, filename.c_str(), "t");
         if (err != LUA_OK)
         {
             std::string errStr = Stack<std::string>::Pop(m_state);
@@ -77,7 +77,7 @@ namespace LuaConnect
         if (environment)
         {
             Stack<Table>::Push(m_state, *environment);
-            lua_setupvalue(m_state->state, -2, 1);
+            lua_setupvalue(m_state.state, -2, 1);
         }
 
         return Stack<Function>::Pop(m_state);
@@ -5,15 +5,50 @@
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 /// Preprocessor
 ///////////////////////////////////////////////////////////////////////////////////////////////////
+#include <LuaConnect\BufferView.h>
 #include <LuaConnect\Exceptions\LuaException.h>
 #include <LuaConnect\Function.h>
+#include <LuaConnect\FunctionArg.h>
+#include <LuaConnect\Key.h>
+#include <LuaConnect\Struct.h>
 #include <LuaConnect\Table.h>
+#include <LuaConnect\TableArg.h>
 #include <LuaConnect\Type.h>
 #include <LuaConnect\Userdata.h>
+#include <LuaConnect\UserdataArg.h>
 #include <LuaConnect\VM.h>
 
 
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
 #include <iostream>
+#include <map>
+#include <memory>
+#include <new>
+#include <optional>
+#include <string_view>
+#include <variant>
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Allocation Counting
+///////////////////////////////////////////////////////////////////////////////////////////////////
+std::size_t g_allocations = 0;
+
+void* operator new(std::size_t size)
+{
+    ++g_allocations;
+
+    if (void* mem = std::malloc(size))
+        return mem;
+
+    throw std::bad_alloc();
+}
+void operator delete(void* mem)
+{
+    std::free(mem);
+}
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 /// Lua Code
@@ -92,6 +127,159 @@ local function passobjects()
     u:PrintMessage()
 end
 
+local function call_printmessageclass()
+    PrintMessageClass():PrintMessage()
+end
+
+local function return_multiple()
+    return 1, "two", true
+end
+local function call_returntuple()
+    local i, s = ReturnTuple()
+    return i * 2, s .. s
+end
+
+local function call_overloaded()
+    return AddValues(1, 2), AddValues(1.5, 2), AddValues("a", "b")
+end
+
+local function call_borrowed()
+    local t = { val = 20 }
+    local result = Borrowed(t, function(n) return n + 1 end)
+    return result, t.seen
+end
+
+local function call_countcalls()
+    CountCalls()
+    CountCalls()
+    return CountCalls()
+end
+
+local function call_wrongself()
+    local obj = PrintMessageClass()
+    local ok = pcall(obj.PrintMessage, ExceptionClass())
+    return ok, pcall(obj.PrintMessage, obj)
+end
+
+local function access_properties()
+    local obj = PropertyClass()
+    obj.value = obj.value + 5
+    obj.ratio = obj.scale * 2
+    local ok = pcall(function() obj.name = "changed" end)
+    local meta = getmetatable(obj)
+    ok = ok or pcall(meta.__index, io.stdout, "value") or pcall(meta.__newindex, {}, "value", 1)
+    return obj.value + obj.ratio, obj.name, ok
+end
+
+local function call_inherited()
+    local obj = DerivedClass()
+    obj.count = obj.count + 1
+    return obj:GetName() .. obj:Describe(), obj.count + obj:GetCount(), BaseCount(obj)
+end
+
+local function use_operators()
+    local a = Vector2(1, 2)
+    local b = Vector2(3, 4)
+    local c = (a + b) * b - a
+    return c:GetX() + c:GetY(), a == Vector2(1, 2), a < b, #c, c(10)
+end
+
+local function call_views()
+    local text = string.rep("word ", 1000)
+    return CountMatches(text, "wo"), FirstWord(text)
+end
+
+local function use_keys(t)
+    t.count = t.count + 1
+    return GetStatus() == "ok"
+end
+
+local function call_containers()
+    local doubled = Doubled({ 1, 2, 3, 4 })
+    local counts = CountWords({ "a", "b", "a" })
+    return doubled[4] + #doubled, counts.a * 10 + counts.b
+end
+
+local function use_buffers(samples, frame)
+    local total = 0
+    for i, v in ipairs(samples) do
+        total = total + v
+    end
+    for i = 1, #frame do
+        frame[i] = frame[i] * 2
+    end
+    local readonly = pcall(function() samples[1] = 0 end)
+    local iterate = ipairs(samples)
+    local strict = samples[1.5] == nil and samples["1"] == nil and not pcall(iterate, nil, 0) and not pcall(iterate, {}, 0)
+    local checked = not pcall(function() frame[1.5] = 0 end) and not pcall(function() frame["1"] = 0 end)
+        and not pcall(function() frame[1] = 2.7 end) and not pcall(function() frame[1] = 2^40 end)
+    return total + frame[#frame], readonly, strict and checked
+end
+local function read_buffer(samples)
+    return samples[1]
+end
+
+local function call_arithmetic()
+    local scaled = Scale(1.5, 4)
+    local narrowed = Narrow(65535)
+    local rejected = not pcall(Narrow, 70000) and not pcall(Narrow, 1.5) and not pcall(Narrow, "text")
+    return scaled + narrowed + Widen(-3), rejected
+end
+
+local function call_variants(v)
+    return Describe(2) .. Describe(2.5) .. Describe("s") .. Describe({}) .. Describe(nil) .. Describe() .. Describe(v)
+end
+
+local function call_structs()
+    local order = Reprice({ id = 7, price = 2.5, lines = { { product = "tea", quantity = 2 } } }, 2)
+    return order.lines[1].product .. (order.id + order.price + #order.lines + order.lines[2].quantity)
+end
+
+local function use_contexts()
+    return MakeContext(1024):Size() + Emplaced:Size() + Moved:Size()
+end
+
+local function use_holders()
+    return SharedResource:Get() + UniqueResource:Get() + OwnedResource:Get()
+end
+
+local function use_references(n)
+    local total = 0
+    for i = 1, n do
+        total = total + GetSprite(i):GetFrame()
+    end
+    return total + SpriteRef:GetFrame() + ContextRef:Size()
+end
+
+local function reject_foreign(v, view)
+    local rejected = 0
+    for _, other in ipairs({ io.stdout, view }) do
+        if not pcall(v.GetX, other) then rejected = rejected + 1 end
+        if not pcall(function() return v + other end) then rejected = rejected + 1 end
+        if not pcall(getmetatable(v).__len, other) then rejected = rejected + 1 end
+    end
+    return rejected
+end
+
+local function call_matching(v, sprite, context)
+    return Measure(v, 2) + Measure(2, 3) + Measure("ab") + Measure("ab", 3) + Locate(sprite) + Locate(context) + Locate(nil)
+end
+
+local function count_down(n)
+    if n == 0 then
+        return
+    end
+    return n, count_down(n - 1)
+end
+
+local function add_loop(n)
+    local total = 0
+    for i = 1, n do
+        total = Add(total, i)
+    end
+    return total
+end
+
 return {
     print_globals = print_globals,
     print_message = print_message,
@@ -114,6 +302,35 @@ return {
     throwexception = throwexception,
 
     passobjects = passobjects,
+
+    call_printmessageclass = call_printmessageclass,
+
+    add_loop = add_loop,
+
+    return_multiple = return_multiple,
+    call_returntuple = call_returntuple,
+
+    call_overloaded = call_overloaded,
+    call_borrowed = call_borrowed,
+    call_countcalls = call_countcalls,
+    call_wrongself = call_wrongself,
+    access_properties = access_properties,
+    call_inherited = call_inherited,
+    use_operators = use_operators,
+    call_views = call_views,
+    use_keys = use_keys,
+    call_containers = call_containers,
+    use_buffers = use_buffers,
+    read_buffer = read_buffer,
+    call_arithmetic = call_arithmetic,
+    call_variants = call_variants,
+    call_structs = call_structs,
+    use_contexts = use_contexts,
+    use_holders = use_holders,
+    use_references = use_references,
+    reject_foreign = reject_foreign,
+    call_matching = call_matching,
+    count_down = count_down,
 }
 )";
 
@@ -224,6 +441,350 @@ LuaConnect::Userdata<PrintMessageClass> ReturnUserdata(LuaConnect::Userdata<VMWr
     return LuaConnect::Userdata<PrintMessageClass>(vm.GetPointer()->vm);
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Test 6
+///////////////////////////////////////////////////////////////////////////////////////////////////
+lua_Integer Add(lua_Integer a, lua_Integer b)
+{
+    return a + b;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Test 8
+///////////////////////////////////////////////////////////////////////////////////////////////////
+std::tuple<lua_Integer, std::string> ReturnTuple()
+{
+    return std::make_tuple(21, "ab");
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Test 9
+///////////////////////////////////////////////////////////////////////////////////////////////////
+class AddFunctor
+{
+public:
+    bool* destroyed;
+    AddFunctor(bool* destroyed) : destroyed(destroyed) { }
+    AddFunctor(AddFunctor&& other) : destroyed(other.destroyed) { other.destroyed = nullptr; }
+    ~AddFunctor() { if (destroyed) *destroyed = true; }
+
+    lua_Integer operator()(lua_Integer a, lua_Integer b) const
+    {
+        return a + b;
+    }
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Test 10
+///////////////////////////////////////////////////////////////////////////////////////////////////
+lua_Integer AddIntegers(lua_Integer a, lua_Integer b)
+{
+    return a + b;
+}
+lua_Number AddNumbers(lua_Number a, lua_Number b)
+{
+    return a + b;
+}
+std::string AddStrings(std::string a, std::string b)
+{
+    return a + b;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Test 11
+///////////////////////////////////////////////////////////////////////////////////////////////////
+lua_Integer Borrowed(LuaConnect::TableArg table, LuaConnect::FunctionArg function)
+{
+    table.Set(std::string("seen"), true);
+
+    // Promote the table, as if it needed to outlive the call
+    LuaConnect::Table kept = table.Promote();
+
+    return function.Call<lua_Integer>(kept.Get<lua_Integer>(std::string("val"))) * 2;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Test 12
+///////////////////////////////////////////////////////////////////////////////////////////////////
+lua_Integer CountCalls(lua_Integer& calls)
+{
+    return ++calls;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Test 14
+///////////////////////////////////////////////////////////////////////////////////////////////////
+class PropertyClass
+{
+public:
+    lua_Integer value = 10;
+    lua_Number ratio = 0.0;
+    lua_Number scale = 1.5;
+    std::string name = "PropertyClass";
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Test 15
+///////////////////////////////////////////////////////////////////////////////////////////////////
+class NamedBase
+{
+public:
+    std::string name = "Derived";
+
+    std::string GetName() const
+    {
+        return name;
+    }
+};
+class CountedBase
+{
+public:
+    lua_Integer count = 1;
+
+    lua_Integer GetCount() const
+    {
+        return count;
+    }
+};
+class DerivedClass : public NamedBase, public CountedBase
+{
+public:
+    std::string Describe() const
+    {
+        return "Class";
+    }
+};
+
+lua_Integer BaseCount(LuaConnect::UserdataArg<CountedBase> counted)
+{
+    return counted.GetPointer()->count;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Test 16
+///////////////////////////////////////////////////////////////////////////////////////////////////
+class Vector2
+{
+public:
+    lua_Number x;
+    lua_Number y;
+
+    Vector2(lua_Number x, lua_Number y) : x(x), y(y) { }
+
+    lua_Number GetX() const { return x; }
+    lua_Number GetY() const { return y; }
+
+    Vector2 operator+(const Vector2& rhs) const { return Vector2(x + rhs.x, y + rhs.y); }
+    Vector2 operator-(const Vector2& rhs) const { return Vector2(x - rhs.x, y - rhs.y); }
+    Vector2 operator*(const Vector2& rhs) const { return Vector2(x * rhs.x, y * rhs.y); }
+
+    bool operator==(const Vector2& rhs) const { return x == rhs.x && y == rhs.y; }
+    bool operator<(const Vector2& rhs) const { return x < rhs.x && y < rhs.y; }
+
+    lua_Number operator()(lua_Number scale) const { return (x + y) * scale; }
+
+    std::size_t size() const { return 2; }
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Test 17
+///////////////////////////////////////////////////////////////////////////////////////////////////
+lua_Integer CountMatches(std::string_view text, const char* pattern)
+{
+    lua_Integer count = 0;
+    for (std::size_t pos = text.find(pattern); pos != std::string_view::npos; pos = text.find(pattern, pos + 1))
+        ++count;
+
+    return count;
+}
+std::string_view FirstWord(std::string_view text)
+{
+    return text.substr(0, text.find(' '));
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Test 18
+///////////////////////////////////////////////////////////////////////////////////////////////////
+LuaConnect::Key GetStatus(const LuaConnect::Key& status)
+{
+    return status;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Test 19
+///////////////////////////////////////////////////////////////////////////////////////////////////
+std::vector<lua_Integer> Doubled(const std::vector<lua_Integer>& values)
+{
+    std::vector<lua_Integer> result;
+    for (lua_Integer value : values)
+        result.push_back(value * 2);
+
+    return result;
+}
+std::map<std::string, lua_Integer> CountWords(const std::vector<std::string>& words)
+{
+    std::map<std::string, lua_Integer> result;
+    for (const std::string& word : words)
+        ++result[word];
+
+    return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Test 21
+///////////////////////////////////////////////////////////////////////////////////////////////////
+float Scale(float value, int factor)
+{
+    return value * factor;
+}
+std::uint16_t Narrow(std::uint16_t value)
+{
+    return value;
+}
+std::size_t Widen(std::int64_t value)
+{
+    return static_cast<std::size_t>(value + 10);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Test 22
+///////////////////////////////////////////////////////////////////////////////////////////////////
+std::string Describe(std::optional<std::variant<lua_Integer, lua_Number, std::string, LuaConnect::TableArg, Vector2>> value)
+{
+    if (!value)
+        return "n";
+
+    switch (value->index())
+    {
+    case 0: return "i";
+    case 1: return "f";
+    case 2: return "s";
+    case 3: return "t";
+    default: return "v";
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Test 23
+///////////////////////////////////////////////////////////////////////////////////////////////////
+struct OrderLine
+{
+    std::string product;
+    lua_Integer quantity;
+};
+
+struct Order
+{
+    lua_Integer id;
+    lua_Number price;
+    std::vector<OrderLine> lines;
+};
+
+namespace LuaConnect
+{
+    template <>
+    struct StructFields<OrderLine>
+    {
+        static constexpr auto fields = std::make_tuple(LUACONNECT_FIELD(OrderLine, product), LUACONNECT_FIELD(OrderLine, quantity));
+    };
+
+    template <>
+    struct StructFields<Order>
+    {
+        static constexpr auto fields = std::make_tuple(LUACONNECT_FIELD(Order, id), LUACONNECT_FIELD(Order, price), LUACONNECT_FIELD(Order, lines));
+    };
+}
+
+Order Reprice(Order order, lua_Number factor)
+{
+    order.price *= factor;
+    order.lines.push_back({ "cup", 3 });
+
+    return order;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Test 24
+///////////////////////////////////////////////////////////////////////////////////////////////////
+class Context
+{
+public:
+    static inline int s_copies = 0;
+
+    std::vector<char> buffer;
+
+    Context(lua_Integer size) : buffer(static_cast<std::size_t>(size)) { }
+    Context(const Context& other) : buffer(other.buffer) { ++s_copies; }
+    Context(Context&& other) = default;
+
+    lua_Integer Size() const { return static_cast<lua_Integer>(buffer.size()); }
+};
+
+Context MakeContext(lua_Integer size)
+{
+    return Context(size);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Test 25
+///////////////////////////////////////////////////////////////////////////////////////////////////
+class Resource
+{
+public:
+    static inline int s_destroyed = 0;
+
+    lua_Integer value;
+
+    Resource(lua_Integer value) : value(value) { }
+    ~Resource() { ++s_destroyed; }
+
+    lua_Integer Get() const { return value; }
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Test 26
+///////////////////////////////////////////////////////////////////////////////////////////////////
+class Sprite
+{
+public:
+    lua_Integer frame;
+
+    Sprite(lua_Integer frame) : frame(frame) { }
+
+    lua_Integer GetFrame() const { return frame; }
+};
+
+Sprite g_sprites[2] = { Sprite(1), Sprite(2) };
+
+Sprite* GetSprite(lua_Integer i)
+{
+    return &g_sprites[i % 2];
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Test 28
+///////////////////////////////////////////////////////////////////////////////////////////////////
+lua_Number MeasureVector(Vector2 v, lua_Number scale)
+{
+    return (v.x + v.y) * scale;
+}
+lua_Number MeasureNumbers(lua_Number a, lua_Number b)
+{
+    return a * b;
+}
+lua_Number MeasureText(std::string text, std::optional<lua_Integer> repeat)
+{
+    return static_cast<lua_Number>(text.size() * repeat.value_or(1));
+}
+lua_Integer LocateSprite(Sprite* sprite)
+{
+    return (sprite != nullptr ? sprite->GetFrame() : 0);
+}
+lua_Integer LocateContext(Context* context)
+{
+    return context->Size() * 10;
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 /// Test 1 - Calling Lua from C++ and vice versa
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -475,6 +1036,981 @@ bool Test5()
     return true;
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Test 6 - Calling C++ functions with primitive signatures without allocating
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool Test6()
+{
+    // Create VM
+    LuaConnect::VM vm;
+
+    // Load the Lua code
+    LuaConnect::Function chunk = vm.LoadBuffer(lua, NULL);
+
+    // Execute the chunk, retrieving the table returned from it
+    LuaConnect::Table table = chunk.Call<LuaConnect::Table>();
+
+    // Register functions
+    vm.GetGlobalTable().Set("Add", LuaConnect::Function::CreateFunction(vm, &Add));
+
+    // Grab the function up front so the measured calls only go through the callback path
+    LuaConnect::Function addLoop = table.Get<LuaConnect::Function>("add_loop");
+
+    // Execute the Lua method, counting allocations made by C++ code
+    lua_Integer total = 0;
+    std::size_t allocations = g_allocations;
+    try
+    {
+        total = addLoop.Call<lua_Integer>((lua_Integer)1000);
+    }
+    catch (const LuaConnect::LuaException& e)
+    {
+        std::cout << e.what() << std::endl;
+        return false;
+    }
+    allocations = g_allocations - allocations;
+
+    std::cout << "Total: " << total << ", allocations: " << allocations << std::endl;
+
+    return (total == 500500 && allocations == 0);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Test 7 - Calling functions bound at compile time from Lua
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool Test7()
+{
+    // Create VM
+    LuaConnect::VM vm;
+
+    // Load the Lua code
+    LuaConnect::Function chunk = vm.LoadBuffer(lua, NULL);
+
+    // Execute the chunk, retrieving the table returned from it
+    LuaConnect::Table table = chunk.Call<LuaConnect::Table>();
+
+    // Register functions and types
+    vm.GetGlobalTable().Set("Add", LuaConnect::Function::CreateFunction<&Add>(vm));
+
+    LuaConnect::Type<PrintMessageClass>::RegisterType(vm, "PrintMessageClass");
+    LuaConnect::Type<PrintMessageClass>::AddConstructor(vm, vm.GetGlobalTable());
+    LuaConnect::Type<PrintMessageClass>::AddFunction<&PrintMessageClass::PrintMessage>(vm, "PrintMessage");
+
+    // Execute relevant Lua methods
+    lua_Integer total = 0;
+    try
+    {
+        total = table.Call<lua_Integer>("add_loop", (lua_Integer)100);
+        table.Call<void>("call_printmessageclass");
+    }
+    catch (const LuaConnect::LuaException& e)
+    {
+        std::cout << e.what() << std::endl;
+        return false;
+    }
+
+    return (total == 5050);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Test 8 - Returning multiple values from Lua and C++
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool Test8()
+{
+    // Create VM
+    LuaConnect::VM vm;
+
+    // Load the Lua code
+    LuaConnect::Function chunk = vm.LoadBuffer(lua, NULL);
+
+    // Execute the chunk, retrieving the table returned from it
+    LuaConnect::Table table = chunk.Call<LuaConnect::Table>();
+
+    // Register functions
+    vm.GetGlobalTable().Set("ReturnTuple", LuaConnect::Function::CreateFunction(vm, &ReturnTuple));
+
+    // Execute relevant Lua methods
+    try
+    {
+        std::tuple<lua_Integer, std::string, bool> multiple = table.Call<std::tuple<lua_Integer, std::string, bool>>("return_multiple");
+        std::pair<lua_Integer, std::string> pair = table.Call<std::pair<lua_Integer, std::string>>("call_returntuple");
+
+        std::cout << std::get<0>(multiple) << " : " << std::get<1>(multiple) << " : " << std::get<2>(multiple) << std::endl;
+        std::cout << pair.first << " : " << pair.second << std::endl;
+
+        return (std::get<0>(multiple) == 1 && std::get<1>(multiple) == "two" && std::get<2>(multiple)
+            && pair.first == 42 && pair.second == "abab");
+    }
+    catch (const LuaConnect::LuaException& e)
+    {
+        std::cout << e.what() << std::endl;
+        return false;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Test 9 - Calling lambdas, functors and std::function from Lua
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool Test9()
+{
+    lua_Integer calls = 0;
+    bool destroyed = false;
+
+    lua_Integer lambdaTotal = 0, functorTotal = 0, functionTotal = 0;
+    {
+        // Create VM
+        LuaConnect::VM vm;
+
+        // Load the Lua code
+        LuaConnect::Function chunk = vm.LoadBuffer(lua, NULL);
+
+        // Execute the chunk, retrieving the table returned from it
+        LuaConnect::Table table = chunk.Call<LuaConnect::Table>();
+
+        // Execute add_loop against each kind of callable
+        try
+        {
+            vm.GetGlobalTable().Set("Add", LuaConnect::Function::CreateFunction(vm, [&calls](lua_Integer a, lua_Integer b) { ++calls; return a + b; }));
+            lambdaTotal = table.Call<lua_Integer>("add_loop", (lua_Integer)100);
+
+            vm.GetGlobalTable().Set("Add", LuaConnect::Function::CreateFunction(vm, AddFunctor(&destroyed)));
+            functorTotal = table.Call<lua_Integer>("add_loop", (lua_Integer)100);
+
+            vm.GetGlobalTable().Set("Add", LuaConnect::Function::CreateFunction(vm, std::function<lua_Integer(lua_Integer, lua_Integer)>(&Add)));
+            functionTotal = table.Call<lua_Integer>("add_loop", (lua_Integer)100);
+        }
+        catch (const LuaConnect::LuaException& e)
+        {
+            std::cout << e.what() << std::endl;
+            return false;
+        }
+    }
+
+    std::cout << "Calls: " << calls << ", functor destroyed: " << destroyed << std::endl;
+
+    // The functor must have been finalized when the VM was closed
+    return (lambdaTotal == 5050 && functorTotal == 5050 && functionTotal == 5050 && calls == 100 && destroyed);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Test 10 - Calling overloaded C++ functions from Lua
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool Test10()
+{
+    // Create VM
+    LuaConnect::VM vm;
+
+    // Load the Lua code
+    LuaConnect::Function chunk = vm.LoadBuffer(lua, NULL);
+
+    // Execute the chunk, retrieving the table returned from it
+    LuaConnect::Table table = chunk.Call<LuaConnect::Table>();
+
+    // Register functions
+    vm.GetGlobalTable().Set("AddValues", LuaConnect::Function::CreateOverloaded(vm, &AddIntegers, &AddNumbers, &AddStrings));
+
+    // Execute relevant Lua methods
+    try
+    {
+        std::tuple<lua_Integer, lua_Number, std::string> results = table.Call<std::tuple<lua_Integer, lua_Number, std::string>>("call_overloaded");
+
+        std::cout << std::get<0>(results) << " : " << std::get<1>(results) << " : " << std::get<2>(results) << std::endl;
+
+        return (std::get<0>(results) == 3 && std::get<1>(results) == 3.5 && std::get<2>(results) == "ab");
+    }
+    catch (const LuaConnect::LuaException& e)
+    {
+        std::cout << e.what() << std::endl;
+        return false;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Test 11 - Passing borrowed tables and functions to C++
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool Test11()
+{
+    // Create VM
+    LuaConnect::VM vm;
+
+    // Load the Lua code
+    LuaConnect::Function chunk = vm.LoadBuffer(lua, NULL);
+
+    // Execute the chunk, retrieving the table returned from it
+    LuaConnect::Table table = chunk.Call<LuaConnect::Table>();
+
+    // Register functions
+    vm.GetGlobalTable().Set("Borrowed", LuaConnect::Function::CreateFunction(vm, &Borrowed));
+
+    // Execute relevant Lua methods
+    try
+    {
+        std::pair<lua_Integer, bool> results = table.Call<std::pair<lua_Integer, bool>>("call_borrowed");
+
+        std::cout << results.first << " : " << results.second << std::endl;
+
+        return (results.first == 42 && results.second);
+    }
+    catch (const LuaConnect::LuaException& e)
+    {
+        std::cout << e.what() << std::endl;
+        return false;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Test 12 - Modifying native upvalues from C++
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool Test12()
+{
+    // Create VM
+    LuaConnect::VM vm;
+
+    // Load the Lua code
+    LuaConnect::Function chunk = vm.LoadBuffer(lua, NULL);
+
+    // Execute the chunk, retrieving the table returned from it
+    LuaConnect::Table table = chunk.Call<LuaConnect::Table>();
+
+    // Register functions, the counter is stored with the function and passed by reference
+    vm.GetGlobalTable().Set("CountCalls", LuaConnect::Function::CreateFunction(vm, &CountCalls, (lua_Integer)0));
+
+    // Execute relevant Lua methods
+    try
+    {
+        lua_Integer calls = table.Call<lua_Integer>("call_countcalls");
+
+        std::cout << "Calls: " << calls << std::endl;
+
+        return (calls == 3);
+    }
+    catch (const LuaConnect::LuaException& e)
+    {
+        std::cout << e.what() << std::endl;
+        return false;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Test 13 - Rejecting userdata of the wrong type as self
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool Test13()
+{
+    // Create VM
+    LuaConnect::VM vm;
+
+    // Load the Lua code
+    LuaConnect::Function chunk = vm.LoadBuffer(lua, NULL);
+
+    // Execute the chunk, retrieving the table returned from it
+    LuaConnect::Table table = chunk.Call<LuaConnect::Table>();
+
+    // Register types
+    LuaConnect::Type<ExceptionClass>::RegisterType(vm, "ExceptionClass");
+    LuaConnect::Type<ExceptionClass>::AddConstructor(vm, vm.GetGlobalTable());
+
+    LuaConnect::Type<PrintMessageClass>::RegisterType(vm, "PrintMessageClass");
+    LuaConnect::Type<PrintMessageClass>::AddConstructor(vm, vm.GetGlobalTable());
+    LuaConnect::Type<PrintMessageClass>::AddFunction(vm, "PrintMessage", &PrintMessageClass::PrintMessage);
+
+    // Execute relevant Lua methods
+    try
+    {
+        std::pair<bool, bool> results = table.Call<std::pair<bool, bool>>("call_wrongself");
+
+        std::cout << results.first << " : " << results.second << std::endl;
+
+        return (!results.first && results.second);
+    }
+    catch (const LuaConnect::LuaException& e)
+    {
+        std::cout << e.what() << std::endl;
+        return false;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Test 14 - Reading and writing member properties
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool Test14()
+{
+    // Create VM
+    LuaConnect::VM vm;
+
+    // Load the Lua code
+    LuaConnect::Function chunk = vm.LoadBuffer(lua, NULL);
+
+    // Execute the chunk, retrieving the table returned from it
+    LuaConnect::Table table = chunk.Call<LuaConnect::Table>();
+
+    // Register types
+    LuaConnect::Type<PropertyClass>::RegisterType(vm, "PropertyClass");
+    LuaConnect::Type<PropertyClass>::AddConstructor(vm, vm.GetGlobalTable());
+    LuaConnect::Type<PropertyClass>::AddProperty(vm, "value", &PropertyClass::value);
+    LuaConnect::Type<PropertyClass>::AddProperty<&PropertyClass::ratio>(vm, "ratio");
+    LuaConnect::Type<PropertyClass>::AddReadOnlyProperty<&PropertyClass::scale>(vm, "scale");
+    LuaConnect::Type<PropertyClass>::AddReadOnlyProperty(vm, "name", &PropertyClass::name);
+
+    // Execute relevant Lua methods
+    try
+    {
+        std::tuple<lua_Number, std::string, bool> results = table.Call<std::tuple<lua_Number, std::string, bool>>("access_properties");
+
+        std::cout << std::get<0>(results) << " : " << std::get<1>(results) << " : " << std::get<2>(results) << std::endl;
+
+        return (std::get<0>(results) == 18.0 && std::get<1>(results) == "PropertyClass" && !std::get<2>(results));
+    }
+    catch (const LuaConnect::LuaException& e)
+    {
+        std::cout << e.what() << std::endl;
+        return false;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Test 15 - Inheriting methods and properties from multiple bases
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool Test15()
+{
+    // Create VM
+    LuaConnect::VM vm;
+
+    // Load the Lua code
+    LuaConnect::Function chunk = vm.LoadBuffer(lua, NULL);
+
+    // Execute the chunk, retrieving the table returned from it
+    LuaConnect::Table table = chunk.Call<LuaConnect::Table>();
+
+    // Register types, bases first
+    LuaConnect::Type<NamedBase>::RegisterType(vm, "NamedBase");
+    LuaConnect::Type<NamedBase>::AddFunction(vm, "GetName", &NamedBase::GetName);
+
+    LuaConnect::Type<CountedBase>::RegisterType(vm, "CountedBase");
+    LuaConnect::Type<CountedBase>::AddFunction(vm, "GetCount", &CountedBase::GetCount);
+    LuaConnect::Type<CountedBase>::AddProperty(vm, "count", &CountedBase::count);
+
+    LuaConnect::Type<DerivedClass>::RegisterType<NamedBase, CountedBase>(vm, "DerivedClass");
+    LuaConnect::Type<DerivedClass>::AddConstructor(vm, vm.GetGlobalTable());
+    LuaConnect::Type<DerivedClass>::AddFunction(vm, "Describe", &DerivedClass::Describe);
+
+    // Register functions taking a base
+    vm.GetGlobalTable().Set("BaseCount", LuaConnect::Function::CreateFunction(vm, &BaseCount));
+
+    // Execute relevant Lua methods
+    try
+    {
+        std::tuple<std::string, lua_Integer, lua_Integer> results = table.Call<std::tuple<std::string, lua_Integer, lua_Integer>>("call_inherited");
+
+        std::cout << std::get<0>(results) << " : " << std::get<1>(results) << " : " << std::get<2>(results) << std::endl;
+
+        return (std::get<0>(results) == "DerivedClass" && std::get<1>(results) == 4 && std::get<2>(results) == 2);
+    }
+    catch (const LuaConnect::LuaException& e)
+    {
+        std::cout << e.what() << std::endl;
+        return false;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Test 16 - Using C++ operators from Lua
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool Test16()
+{
+    // Create VM
+    LuaConnect::VM vm;
+
+    // Load the Lua code
+    LuaConnect::Function chunk = vm.LoadBuffer(lua, NULL);
+
+    // Execute the chunk, retrieving the table returned from it
+    LuaConnect::Table table = chunk.Call<LuaConnect::Table>();
+
+    // Register types, operators are detected and registered automatically
+    LuaConnect::Type<Vector2>::RegisterType(vm, "Vector2");
+    LuaConnect::Type<Vector2>::AddConstructor<lua_Number, lua_Number>(vm, vm.GetGlobalTable());
+    LuaConnect::Type<Vector2>::AddFunction(vm, "GetX", &Vector2::GetX);
+    LuaConnect::Type<Vector2>::AddFunction(vm, "GetY", &Vector2::GetY);
+
+    // Execute relevant Lua methods
+    try
+    {
+        using Results = std::tuple<lua_Number, bool, bool, lua_Integer, lua_Number>;
+        Results results = table.Call<Results>("use_operators");
+
+        std::cout << std::get<0>(results) << " : " << std::get<1>(results) << " : " << std::get<2>(results) << " : " << std::get<3>(results) << " : " << std::get<4>(results) << std::endl;
+
+        // (1 + 3) * 3 - 1 = 11, (2 + 4) * 4 - 2 = 22
+        return (std::get<0>(results) == 33.0 && std::get<1>(results) && std::get<2>(results) && std::get<3>(results) == 2 && std::get<4>(results) == 330.0);
+    }
+    catch (const LuaConnect::LuaException& e)
+    {
+        std::cout << e.what() << std::endl;
+        return false;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Test 17 - Passing strings to C++ without copying them
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool Test17()
+{
+    // Create VM
+    LuaConnect::VM vm;
+
+    // Load the Lua code
+    LuaConnect::Function chunk = vm.LoadBuffer(lua, NULL);
+
+    // Execute the chunk, retrieving the table returned from it
+    LuaConnect::Table table = chunk.Call<LuaConnect::Table>();
+
+    // Register functions
+    vm.GetGlobalTable().Set("CountMatches", LuaConnect::Function::CreateFunction(vm, &CountMatches));
+    vm.GetGlobalTable().Set("FirstWord", LuaConnect::Function::CreateFunction(vm, &FirstWord));
+
+    // Execute relevant Lua methods, counting the allocations made on the C++ side
+    try
+    {
+        std::size_t allocations = g_allocations;
+        std::pair<lua_Integer, std::string> results = table.Call<std::pair<lua_Integer, std::string>>("call_views");
+        allocations = g_allocations - allocations;
+
+        std::cout << results.first << " : " << results.second << " : " << allocations << " allocations" << std::endl;
+
+        // Only the returned std::string may allocate
+        return (results.first == 1000 && results.second == "word" && allocations <= 1);
+    }
+    catch (const LuaConnect::LuaException& e)
+    {
+        std::cout << e.what() << std::endl;
+        return false;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Test 18 - Accessing tables with interned keys
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool Test18()
+{
+    // Create VM
+    LuaConnect::VM vm;
+
+    // Load the Lua code
+    LuaConnect::Function chunk = vm.LoadBuffer(lua, NULL);
+
+    // Execute the chunk, retrieving the table returned from it
+    LuaConnect::Table table = chunk.Call<LuaConnect::Table>();
+
+    // Intern keys once, keys for the same string share a slot
+    LuaConnect::Key count(vm, "count");
+    LuaConnect::Key useKeys(vm, "use_keys");
+    LuaConnect::Key status(vm, "ok");
+
+    if (count != LuaConnect::Key(vm, "count"))
+        return false;
+
+    // Register functions, returning an interned string as a value
+    vm.GetGlobalTable().Set("GetStatus", LuaConnect::Function::CreateFunction(vm, &GetStatus, status));
+
+    // Execute relevant Lua methods
+    try
+    {
+        LuaConnect::Table data(vm);
+        data.Set(count, (lua_Integer)41);
+
+        bool ok = table.Call<bool>(useKeys, data);
+        lua_Integer result = data.Get<lua_Integer>(count);
+
+        std::cout << result << " : " << ok << std::endl;
+
+        if (result != 42 || !ok || !data.Exists(count))
+            return false;
+    }
+    catch (const LuaConnect::LuaException& e)
+    {
+        std::cout << e.what() << std::endl;
+        return false;
+    }
+
+    // Keys which are empty or belong to another VM can't be pushed
+    LuaConnect::VM other;
+    LuaConnect::Key foreign(other, "count");
+
+    if (foreign == count)
+        return false;
+
+    for (const LuaConnect::Key& key : { LuaConnect::Key(), foreign })
+    {
+        try
+        {
+            LuaConnect::Table data(vm);
+            data.Set(key, (lua_Integer)1);
+
+            return false;
+        }
+        catch (const LuaConnect::LuaException& e)
+        {
+            std::cout << e.what() << std::endl;
+        }
+    }
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Test 19 - Passing STL containers to and from Lua
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool Test19()
+{
+    // Create VM
+    LuaConnect::VM vm;
+
+    // Load the Lua code
+    LuaConnect::Function chunk = vm.LoadBuffer(lua, NULL);
+
+    // Execute the chunk, retrieving the table returned from it
+    LuaConnect::Table table = chunk.Call<LuaConnect::Table>();
+
+    // Register functions
+    vm.GetGlobalTable().Set("Doubled", LuaConnect::Function::CreateFunction(vm, &Doubled));
+    vm.GetGlobalTable().Set("CountWords", LuaConnect::Function::CreateFunction(vm, &CountWords));
+
+    // Execute relevant Lua methods
+    try
+    {
+        std::pair<lua_Integer, lua_Integer> results = table.Call<std::pair<lua_Integer, lua_Integer>>("call_containers");
+
+        std::cout << results.first << " : " << results.second << std::endl;
+
+        if (results.first != 12 || results.second != 21)
+            return false;
+    }
+    catch (const LuaConnect::LuaException& e)
+    {
+        std::cout << e.what() << std::endl;
+        return false;
+    }
+
+    // Elements which fail to convert, or a length which doesn't fit, raise an error leaving the stack as it was
+    LuaConnect::Table mixed(vm);
+    mixed.Set((lua_Integer)1, (lua_Integer)1);
+    mixed.Set((lua_Integer)2, std::string("x"));
+
+    LuaConnect::Table holder(vm);
+    holder.Set(std::string("list"), mixed);
+
+    int rejected = 0;
+    try { holder.Get<std::vector<lua_Integer>>(std::string("list")); } catch (const LuaConnect::LuaException&) { ++rejected; }
+    try { holder.Get<std::array<lua_Integer, 3>>(std::string("list")); } catch (const LuaConnect::LuaException&) { ++rejected; }
+    try { holder.Get<std::map<lua_Integer, lua_Integer>>(std::string("list")); } catch (const LuaConnect::LuaException&) { ++rejected; }
+
+    std::cout << rejected << std::endl;
+
+    return (rejected == 3 && holder.Get<std::vector<std::string>>(std::string("list")).size() == 2);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Test 20 - Viewing C++ buffers from Lua without copying
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool Test20()
+{
+    // Create VM
+    LuaConnect::VM vm;
+
+    // Load the Lua code
+    LuaConnect::Function chunk = vm.LoadBuffer(lua, NULL);
+
+    // Execute the chunk, retrieving the table returned from it
+    LuaConnect::Table table = chunk.Call<LuaConnect::Table>();
+
+    // Memory owned by C++, viewed read only and mutably from Lua
+    const double samples[] = { 0.5, 1.5, 2.0 };
+    std::int32_t frame[] = { 1, 2, 3, 4 };
+
+    LuaConnect::BufferView<const double> samplesView(vm, samples, 3);
+    LuaConnect::BufferView<std::int32_t> frameView(vm, frame, 4);
+
+    // Execute relevant Lua methods
+    try
+    {
+        using Results = std::tuple<lua_Number, bool, bool>;
+        Results results = table.Call<Results>("use_buffers", samplesView, frameView);
+
+        std::cout << std::get<0>(results) << " : " << std::get<1>(results) << " : " << std::get<2>(results) << " : " << frame[0] << std::endl;
+
+        if (std::get<0>(results) != 12.0 || std::get<1>(results) || !std::get<2>(results) || frame[0] != 2)
+            return false;
+    }
+    catch (const LuaConnect::LuaException& e)
+    {
+        std::cout << e.what() << std::endl;
+        return false;
+    }
+
+    // Once invalidated, any access from Lua raises an error
+    samplesView.Invalidate();
+    try
+    {
+        table.Call<lua_Number>("read_buffer", samplesView);
+        return false;
+    }
+    catch (const LuaConnect::LuaException& e)
+    {
+        std::cout << e.what() << std::endl;
+        return true;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Test 21 - Converting every arithmetic width, with range checks
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool Test21()
+{
+    // Create VM
+    LuaConnect::VM vm;
+
+    // Load the Lua code
+    LuaConnect::Function chunk = vm.LoadBuffer(lua, NULL);
+
+    // Execute the chunk, retrieving the table returned from it
+    LuaConnect::Table table = chunk.Call<LuaConnect::Table>();
+
+    // Register functions
+    vm.GetGlobalTable().Set("Scale", LuaConnect::Function::CreateFunction(vm, &Scale));
+    vm.GetGlobalTable().Set("Narrow", LuaConnect::Function::CreateFunction(vm, &Narrow));
+    vm.GetGlobalTable().Set("Widen", LuaConnect::Function::CreateFunction(vm, &Widen));
+
+    // Execute relevant Lua methods
+    try
+    {
+        std::pair<double, bool> results = table.Call<std::pair<double, bool>>("call_arithmetic");
+
+        std::cout << results.first << " : " << results.second << std::endl;
+
+        return (results.first == 65548.0 && results.second);
+    }
+    catch (const LuaConnect::LuaException& e)
+    {
+        std::cout << e.what() << std::endl;
+        return false;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Test 22 - Passing optional and variant arguments
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool Test22()
+{
+    // Create VM
+    LuaConnect::VM vm;
+
+    // Load the Lua code
+    LuaConnect::Function chunk = vm.LoadBuffer(lua, NULL);
+
+    // Execute the chunk, retrieving the table returned from it
+    LuaConnect::Table table = chunk.Call<LuaConnect::Table>();
+
+    // Register types and functions
+    LuaConnect::Type<Vector2>::RegisterType(vm, "Vector2");
+    vm.GetGlobalTable().Set("Describe", LuaConnect::Function::CreateFunction(vm, &Describe));
+
+    LuaConnect::Userdata<Vector2> vector = LuaConnect::Userdata<Vector2>::Emplace(vm, 1.0, 2.0);
+
+    // Execute relevant Lua methods
+    try
+    {
+        std::string result = table.Call<std::string>("call_variants", vector);
+
+        std::cout << result << std::endl;
+
+        return (result == "ifstnnv");
+    }
+    catch (const LuaConnect::LuaException& e)
+    {
+        std::cout << e.what() << std::endl;
+        return false;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Test 23 - Converting described structs to and from tables
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool Test23()
+{
+    // Create VM
+    LuaConnect::VM vm;
+
+    // Load the Lua code
+    LuaConnect::Function chunk = vm.LoadBuffer(lua, NULL);
+
+    // Execute the chunk, retrieving the table returned from it
+    LuaConnect::Table table = chunk.Call<LuaConnect::Table>();
+
+    // Register functions
+    vm.GetGlobalTable().Set("Reprice", LuaConnect::Function::CreateFunction(vm, &Reprice));
+
+    // Execute relevant Lua methods
+    try
+    {
+        std::string result = table.Call<std::string>("call_structs");
+
+        std::cout << result << std::endl;
+
+        return (result == "tea17");
+    }
+    catch (const LuaConnect::LuaException& e)
+    {
+        std::cout << e.what() << std::endl;
+        return false;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Test 24 - Moving and emplacing objects into userdata
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool Test24()
+{
+    Context::s_copies = 0;
+
+    // Create VM
+    LuaConnect::VM vm;
+
+    // Load the Lua code
+    LuaConnect::Function chunk = vm.LoadBuffer(lua, NULL);
+
+    // Execute the chunk, retrieving the table returned from it
+    LuaConnect::Table table = chunk.Call<LuaConnect::Table>();
+
+    // Register types and functions
+    LuaConnect::Type<Context>::RegisterType(vm, "Context");
+    LuaConnect::Type<Context>::AddFunction(vm, "Size", &Context::Size);
+    vm.GetGlobalTable().Set("MakeContext", LuaConnect::Function::CreateFunction(vm, &MakeContext));
+
+    // Create userdata without copying the objects
+    vm.GetGlobalTable().Set("Emplaced", LuaConnect::Userdata<Context>::Emplace(vm, 512));
+    vm.GetGlobalTable().Set("Moved", LuaConnect::Userdata<Context>::CreateMove(vm, Context(256)));
+
+    // Execute relevant Lua methods
+    try
+    {
+        lua_Integer result = table.Call<lua_Integer>("use_contexts");
+
+        std::cout << result << " : " << Context::s_copies << std::endl;
+
+        return (result == 1792 && Context::s_copies == 0);
+    }
+    catch (const LuaConnect::LuaException& e)
+    {
+        std::cout << e.what() << std::endl;
+        return false;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Test 25 - Handing smart pointers to Lua
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool Test25()
+{
+    Resource::s_destroyed = 0;
+
+    std::shared_ptr<Resource> shared = std::make_shared<Resource>(5);
+    lua_Integer result = 0;
+
+    {
+        // Create VM
+        LuaConnect::VM vm;
+
+        // Load the Lua code
+        LuaConnect::Function chunk = vm.LoadBuffer(lua, NULL);
+
+        // Execute the chunk, retrieving the table returned from it
+        LuaConnect::Table table = chunk.Call<LuaConnect::Table>();
+
+        // Register types
+        LuaConnect::Type<Resource>::RegisterType(vm, "Resource");
+        LuaConnect::Type<Resource>::AddFunction(vm, "Get", &Resource::Get);
+
+        // Hand each kind of pointer to Lua, sharing the same metatable
+        vm.GetGlobalTable().Set("SharedResource", LuaConnect::Userdata<Resource>::CreateShared(vm, shared));
+        vm.GetGlobalTable().Set("UniqueResource", LuaConnect::Userdata<Resource>::CreateUnique(vm, std::make_unique<Resource>(7)));
+        vm.GetGlobalTable().Set("OwnedResource", LuaConnect::Userdata<Resource>::CreateOwned(vm, new Resource(9)));
+
+        // Execute relevant Lua methods
+        try
+        {
+            result = table.Call<lua_Integer>("use_holders");
+        }
+        catch (const LuaConnect::LuaException& e)
+        {
+            std::cout << e.what() << std::endl;
+            return false;
+        }
+    }
+
+    std::cout << result << " : " << Resource::s_destroyed << " : " << shared.use_count() << std::endl;
+
+    // Closing the VM releases every holder, destroying only the objects Lua owned
+    return (result == 21 && Resource::s_destroyed == 2 && shared.use_count() == 1);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Test 26 - Referencing C++ owned objects from Lua
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool Test26()
+{
+    // Create VM
+    LuaConnect::VM vm;
+
+    // Load the Lua code
+    LuaConnect::Function chunk = vm.LoadBuffer(lua, NULL);
+
+    // Execute the chunk, retrieving the table returned from it
+    LuaConnect::Table table = chunk.Call<LuaConnect::Table>();
+
+    // Register types, each reference must keep its own type's metatable
+    LuaConnect::Type<Sprite>::RegisterType(vm, "Sprite");
+    LuaConnect::Type<Sprite>::AddFunction(vm, "GetFrame", &Sprite::GetFrame);
+    LuaConnect::Type<Context>::RegisterType(vm, "Context");
+    LuaConnect::Type<Context>::AddFunction(vm, "Size", &Context::Size);
+
+    // Register functions, returned pointers are pushed as references
+    vm.GetGlobalTable().Set("GetSprite", LuaConnect::Function::CreateFunction(vm, &GetSprite));
+
+    // Reference objects owned by C++
+    Sprite sprite(100);
+    Context context(1000);
+    vm.GetGlobalTable().Set("SpriteRef", LuaConnect::Userdata<Sprite>::CreateRef(vm, sprite));
+    vm.GetGlobalTable().Set("ContextRef", LuaConnect::Userdata<Context>::CreateRef(vm, context));
+
+    // Execute relevant Lua methods
+    try
+    {
+        lua_Integer result = table.Call<lua_Integer>("use_references", (lua_Integer)1000);
+
+        std::cout << result << std::endl;
+
+        // 500 * 1 + 500 * 2 + 100 + 1000
+        return (result == 2600);
+    }
+    catch (const LuaConnect::LuaException& e)
+    {
+        std::cout << e.what() << std::endl;
+        return false;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Test 27 - Rejecting userdata not created by LuaConnect
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool Test27()
+{
+    // Create VM
+    LuaConnect::VM vm;
+
+    // Load the Lua code
+    LuaConnect::Function chunk = vm.LoadBuffer(lua, NULL);
+
+    // Execute the chunk, retrieving the table returned from it
+    LuaConnect::Table table = chunk.Call<LuaConnect::Table>();
+
+    // Register types
+    LuaConnect::Type<Vector2>::RegisterType(vm, "Vector2");
+    LuaConnect::Type<Vector2>::AddFunction(vm, "GetX", &Vector2::GetX);
+
+    // A registered object, and a view whose userdata has no header
+    std::int32_t frame[] = { 1, 2, 3, 4 };
+    LuaConnect::Userdata<Vector2> vector = LuaConnect::Userdata<Vector2>::Emplace(vm, 1.0, 2.0);
+    LuaConnect::BufferView<std::int32_t> view(vm, frame, 4);
+
+    // Execute relevant Lua methods, passing foreign userdata as self and as operands
+    try
+    {
+        lua_Integer rejected = table.Call<lua_Integer>("reject_foreign", vector, view);
+
+        std::cout << rejected << std::endl;
+
+        return (rejected == 6);
+    }
+    catch (const LuaConnect::LuaException& e)
+    {
+        std::cout << e.what() << std::endl;
+        return false;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Test 28 - Matching overloads taking registered types and optional arguments
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool Test28()
+{
+    // Create VM
+    LuaConnect::VM vm;
+
+    // Load the Lua code
+    LuaConnect::Function chunk = vm.LoadBuffer(lua, NULL);
+
+    // Execute the chunk, retrieving the table returned from it
+    LuaConnect::Table table = chunk.Call<LuaConnect::Table>();
+
+    // Register types and functions
+    LuaConnect::Type<Vector2>::RegisterType(vm, "Vector2");
+    LuaConnect::Type<Sprite>::RegisterType(vm, "Sprite");
+    LuaConnect::Type<Context>::RegisterType(vm, "Context");
+    vm.GetGlobalTable().Set("Measure", LuaConnect::Function::CreateOverloaded(vm, &MeasureVector, &MeasureNumbers, &MeasureText));
+    vm.GetGlobalTable().Set("Locate", LuaConnect::Function::CreateOverloaded(vm, &LocateSprite, &LocateContext));
+
+    LuaConnect::Userdata<Vector2> vector = LuaConnect::Userdata<Vector2>::Emplace(vm, 1.0, 2.0);
+    LuaConnect::Userdata<Sprite> sprite = LuaConnect::Userdata<Sprite>::Emplace(vm, 3);
+    LuaConnect::Userdata<Context> context = LuaConnect::Userdata<Context>::Emplace(vm, 4);
+
+    // Execute relevant Lua methods
+    try
+    {
+        lua_Number result = table.Call<lua_Number>("call_matching", vector, sprite, context);
+
+        std::cout << result << std::endl;
+
+        // (1 + 2) * 2 + 2 * 3 + 2 + 2 * 3 + 3 + 4 * 10 + 0
+        return (result == 63.0);
+    }
+    catch (const LuaConnect::LuaException& e)
+    {
+        std::cout << e.what() << std::endl;
+        return false;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Test 29 - Calling Lua functions returning a variable number of results
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool Test29()
+{
+    // Create VM
+    LuaConnect::VM vm;
+
+    // Load the Lua code
+    LuaConnect::Function chunk = vm.LoadBuffer(lua, NULL);
+
+    // Execute the chunk, retrieving the table returned from it
+    LuaConnect::Table table = chunk.Call<LuaConnect::Table>();
+
+    // Execute relevant Lua methods, taking however many results they return
+    try
+    {
+        std::vector<lua_Integer> results = table.CallAll<lua_Integer>("count_down", (lua_Integer)4);
+        std::vector<lua_Integer> none = table.Get<LuaConnect::Function>(std::string("count_down")).CallAll<lua_Integer>((lua_Integer)0);
+
+        std::cout << results.size() << " : " << none.size() << std::endl;
+
+        return (results == std::vector<lua_Integer>{ 4, 3, 2, 1 } && none.empty());
+    }
+    catch (const LuaConnect::LuaException& e)
+    {
+        std::cout << e.what() << std::endl;
+        return false;
+    }
+}
+
 #include <vector>
 std::vector<bool(*)()> m_tests =
 {
@@ -482,7 +2018,31 @@ std::vector<bool(*)()> m_tests =
     &Test2,
     &Test3,
     &Test4,
-    &Test5
+    &Test5,
+    &Test6,
+    &Test7,
+    &Test8,
+    &Test9,
+    &Test10,
+    &Test11,
+    &Test12,
+    &Test13,
+    &Test14,
+    &Test15,
+    &Test16,
+    &Test17,
+    &Test18,
+    &Test19,
+    &Test20,
+    &Test21,
+    &Test22,
+    &Test23,
+    &Test24,
+    &Test25,
+    &Test26,
+    &Test27,
+    &Test28,
+    &Test29
 };
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////